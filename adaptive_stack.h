@@ -0,0 +1,289 @@
+/*
+ * adaptive_stack.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Adaptive Stack - Treiber, elimination or combining by contention.
+ */
+
+#ifndef ADAPTIVE_STACK_H
+#define ADAPTIVE_STACK_H
+
+#include "containers.h"
+
+/* Destructor: drain and free all nodes */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::~adaptive_stack() {
+    while(top.load().ptr) {
+        node* n = top.load().ptr;
+        top.store(n->next.load(std::memory_order_relaxed));
+        Alloc::destroy(n);
+    }
+}
+
+/* The calling thread's publication slot, counted into the combiner's scan */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+typename adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::slot&
+adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::my_slot() {
+    std::size_t i = thread_index() % ADAPT_SLOTS;
+    std::size_t used = slots_used.load(std::memory_order_relaxed);
+    while(used <= i && !slots_used.compare_exchange_weak(used, i + 1)) {}
+    return slots[i];
+}
+
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+void adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::shift(int from, int to) {
+    if(current.compare_exchange_strong(from, to)) stat_add(STAT_ADAPT_SWITCHES);
+}
+
+/* Count one op and its failed CASes into the slot's window; at the end of
+   a window move up past ADAPT_FAIL_HIGH failures per 100 ops, and from
+   elimination back to plain Treiber under ADAPT_FAIL_LOW. Threads sharing
+   a slot race on the counts, which only blurs the estimate. */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+void adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::sample(slot& s, unsigned fails) {
+    unsigned ops = s.ops.load(std::memory_order_relaxed) + 1;
+    unsigned f = s.fails.load(std::memory_order_relaxed) + fails;
+    if(ops < ADAPT_WINDOW) {
+        s.ops.store(ops, std::memory_order_relaxed);
+        s.fails.store(f, std::memory_order_relaxed);
+        return;
+    }
+    s.ops.store(0, std::memory_order_relaxed);
+    s.fails.store(0, std::memory_order_relaxed);
+    unsigned pct = (unsigned)((std::uint64_t)f * 100 / ops);
+    int m = current.load(std::memory_order_relaxed);
+    if(pct > ADAPT_FAIL_HIGH && m != ADAPT_COMBINING) shift(m, m + 1);
+    else if(pct < ADAPT_FAIL_LOW && m == ADAPT_ELIMINATION) shift(m, ADAPT_TREIBER);
+}
+
+/* Hand op to the combiner through the slot and wait, combining ourselves
+   whenever the lock is free. False if another thread holds the slot, the
+   caller then takes the CAS path. */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+bool adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::publish(slot& s, int op, node*& n, bool& listed,
+                                                                     typename Reclaim::guard& g) {
+    bool expected = false;
+    if(s.claimed.load(std::memory_order_relaxed) ||
+       !s.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        return false;
+    s.n = n;
+    s.op.store(op, std::memory_order_release);
+    typename Backoff::state b;
+    while(s.op.load(std::memory_order_acquire) != 0) {
+        if(combiner.try_lock()) {
+            combine(g);
+            combiner.unlock();
+        } else {
+            b.pause();
+        }
+    }
+    n = s.n;
+    listed = s.listed;
+    s.claimed.store(false, std::memory_order_release);
+    return true;
+}
+
+/* One pass over the slots: pair pushes with pops, splice the remaining
+   pushes in with one CAS, and pop for the remaining pops. The top still
+   takes CASes from ops of an earlier mode, so every change goes through
+   a CAS as on the lock-free path. Slot fields are read before the slot is
+   released, since its owner may reuse it right after. */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+void adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::combine(typename Reclaim::guard& g) {
+    slot* pushes[ADAPT_SLOTS];
+    slot* pops[ADAPT_SLOTS];
+    std::size_t np = 0, nq = 0, used = slots_used.load(std::memory_order_acquire);
+    for(std::size_t i = 0; i < used; i++) {
+        int op = slots[i].op.load(std::memory_order_acquire);
+        if(op == 1) pushes[np++] = &slots[i];
+        else if(op == 2) pops[nq++] = &slots[i];
+    }
+    if(np + nq == 0) return;
+    stat_add(STAT_FC_COMBINES);
+    stat_add(STAT_FC_PASSES);
+    stat_add(STAT_FC_OPS, np + nq);
+
+    std::size_t paired = np < nq ? np : nq;
+    for(std::size_t j = 0; j < paired; j++) {
+        pops[j]->n = pushes[j]->n;
+        pops[j]->listed = false;
+        pushes[j]->op.store(0, std::memory_order_release);
+        pops[j]->op.store(0, std::memory_order_release);
+    }
+    stat_add(STAT_FC_PAIRED, 2 * paired);
+
+    typename Backoff::state b;
+    if(np > paired) {
+        node* last = pushes[paired]->n;
+        node* first = last;
+        for(std::size_t j = paired + 1; j < np; j++) {
+            pushes[j]->n->next.store(first, std::memory_order_relaxed);
+            first = pushes[j]->n;
+        }
+        while(true) {
+            tagged<node> old_top = top.load();
+            last->next.store(old_top.ptr, std::memory_order_relaxed);
+            if(stat_cas(top.compare_exchange(old_top, first))) break;
+            b.pause();
+        }
+        for(std::size_t j = paired; j < np; j++)
+            pushes[j]->op.store(0, std::memory_order_release);
+    }
+    for(std::size_t j = paired; j < nq; j++) {
+        node* got = nullptr;
+        while(true) {
+            tagged<node> old_top = g.protect(0, top);
+            if(!old_top.ptr) break;
+            node* next = old_top.ptr->next.load(std::memory_order_relaxed);
+            if(stat_cas(top.compare_exchange(old_top, next))) {
+                got = old_top.ptr;
+                break;
+            }
+            b.pause();
+        }
+        g.clear(0);
+        pops[j]->n = got;
+        pops[j]->listed = true;
+        pops[j]->op.store(0, std::memory_order_release);
+    }
+
+    /* Mean batch over the last ADAPT_WINDOW ops served */
+    passes++;
+    served += (unsigned)(np + nq);
+    if(served >= ADAPT_WINDOW) {
+        if(served < passes * ADAPT_BATCH_LOW) shift(ADAPT_COMBINING, ADAPT_ELIMINATION);
+        passes = served = 0;
+    }
+}
+
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+void adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::push_node(node* n) {
+    typename Reclaim::guard g;
+    typename Backoff::state b;
+    slot& s = my_slot();
+    unsigned fails = 0;
+    while(true) {
+        int m = current.load(std::memory_order_relaxed);
+        if(m == ADAPT_COMBINING) {
+            node* r = n;
+            bool listed;
+            if(publish(s, 1, r, listed, g)) break;
+        }
+        tagged<node> old_top = top.load();
+        n->next.store(old_top.ptr, std::memory_order_relaxed);
+        if(stat_cas(top.compare_exchange(old_top, n))) break;
+        fails++;
+        if(m == ADAPT_ELIMINATION && elim.exchange_push(n)) break;
+        b.pause();
+    }
+    sample(s, fails);
+}
+
+/* One pop by the current mode. A node that came off the list may still be
+   read by other poppers and is retired; one handed over by a push (through
+   the collision array or the combiner) never was on it and is freed. */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+bool adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop_one(T& out) {
+    typename Reclaim::guard g;
+    typename Backoff::state b;
+    slot& s = my_slot();
+    unsigned fails = 0;
+    node* got = nullptr;
+    bool listed = true;
+    while(true) {
+        int m = current.load(std::memory_order_relaxed);
+        if(m == ADAPT_COMBINING && publish(s, 2, got, listed, g)) break;
+
+        tagged<node> old_top = g.protect(0, top);
+        if(!old_top.ptr) break;
+        node* next = old_top.ptr->next.load(std::memory_order_relaxed);
+        if(stat_cas(top.compare_exchange(old_top, next))) {
+            got = old_top.ptr;
+            g.clear(0);
+            break;
+        }
+        fails++;
+        if(m == ADAPT_ELIMINATION) {
+            if(node* e = static_cast<node*>(elim.exchange_pop())) {
+                got = e;
+                listed = false;
+                break;
+            }
+        }
+        b.pause();
+    }
+    sample(s, fails);
+    if(!got) return false;
+    out = std::move(got->value);
+    if(listed) Reclaim::retire(got, free_node);
+    else Alloc::destroy(got);
+    return true;
+}
+
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+template<typename... Args>
+void adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::emplace(Args&&... args) {
+    push_node(Alloc::template create<node>(std::forward<Args>(args)...));
+    nonempty.notify();
+}
+
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+T adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop() {
+    T v;
+    if(!pop_one(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+std::optional<T> adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::try_pop() {
+    T v;
+    if(!pop_one(v)) return std::nullopt;
+    return v;
+}
+
+/* Blocking pop: spin, then sleep until a push */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+T adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop_wait() {
+    T v;
+    await_item(nonempty, [&] { return pop_one(v); });
+    return v;
+}
+
+/* Timed pop: nullopt if nothing arrived before the timeout */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+template<typename Rep, typename Period>
+std::optional<T> adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop_for(const std::chrono::duration<Rep, Period>& timeout) {
+    T v;
+    if(!await_item(nonempty, [&] { return pop_one(v); }, wait_deadline(timeout))) return std::nullopt;
+    return v;
+}
+
+/* Bulk push: splice a pre-linked chain with one CAS in every mode */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+void adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::push_n(const T* values, std::size_t n) {
+    if(n == 0) return;
+    node* last = Alloc::template create<node>(values[0]);
+    node* first = last;
+    for(std::size_t i = 1; i < n; i++) {
+        node* n2 = Alloc::template create<node>(values[i]);
+        n2->next.store(first, std::memory_order_relaxed);
+        first = n2;
+    }
+    typename Backoff::state b;
+    while(true) {
+        tagged<node> old_top = top.load();
+        last->next.store(old_top.ptr, std::memory_order_relaxed);
+        if(stat_cas(top.compare_exchange(old_top, first))) break;
+        b.pause();
+    }
+    nonempty.notify(n);
+}
+
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+std::size_t adaptive_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop_n(T* out, std::size_t n) {
+    std::size_t got = 0;
+    while(got < n && pop_one(out[got])) got++;
+    return got;
+}
+
+#endif
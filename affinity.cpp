@@ -0,0 +1,120 @@
+/*
+ * affinity.cpp
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: CPU topology from sysfs and thread pinning.
+ */
+
+#include "affinity.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/* Where one CPU sits: socket, core, and its rank among the core's
+   hardware threads; core_rank numbers the cores within the socket */
+struct cpu_place {
+    int cpu, package, core, core_rank, sibling;
+};
+
+static int read_id(int cpu, const char* file, int fallback) {
+    std::ifstream in("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + file);
+    int v;
+    return in >> v ? v : fallback;
+}
+
+/* CPUs this process may run on, in id order */
+static std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for(int c = 0; c < CPU_SETSIZE; c++)
+            if(CPU_ISSET(c, &set)) cpus.push_back(c);
+    }
+#endif
+    if(cpus.empty()) {
+        unsigned n = std::thread::hardware_concurrency();
+        for(unsigned c = 0; c < (n ? n : 1); c++) cpus.push_back((int)c);
+    }
+    return cpus;
+}
+
+static std::vector<cpu_place> topology() {
+    std::vector<cpu_place> places;
+    for(int c : allowed_cpus())
+        places.push_back({c, read_id(c, "physical_package_id", 0), read_id(c, "core_id", c), 0, 0});
+
+    /* Siblings and core ranks follow from the (package, core) pairs */
+    std::sort(places.begin(), places.end(), [](const cpu_place& a, const cpu_place& b) {
+        if(a.package != b.package) return a.package < b.package;
+        if(a.core != b.core) return a.core < b.core;
+        return a.cpu < b.cpu;
+    });
+    for(std::size_t i = 0; i < places.size(); i++) {
+        if(i == 0 || places[i].package != places[i - 1].package) {
+            places[i].core_rank = 0;
+            places[i].sibling = 0;
+        } else if(places[i].core != places[i - 1].core) {
+            places[i].core_rank = places[i - 1].core_rank + 1;
+            places[i].sibling = 0;
+        } else {
+            places[i].core_rank = places[i - 1].core_rank;
+            places[i].sibling = places[i - 1].sibling + 1;
+        }
+    }
+    return places;
+}
+
+static std::vector<int> build_order(pin_policy p) {
+    std::vector<cpu_place> places = topology();
+    auto key = [p](const cpu_place& c) {
+        if(p == PIN_SCATTER) return std::make_tuple(c.sibling, c.core_rank, c.package);
+        if(p == PIN_SMT) return std::make_tuple(c.package, c.core_rank, c.sibling);
+        return std::make_tuple(c.sibling, c.package, c.core_rank);
+    };
+    std::stable_sort(places.begin(), places.end(),
+                     [&](const cpu_place& a, const cpu_place& b) { return key(a) < key(b); });
+    std::vector<int> order;
+    for(const cpu_place& c : places) order.push_back(c.cpu);
+    return order;
+}
+
+const std::vector<int>& pin_order(pin_policy p) {
+    static const std::vector<int> none;
+    static const std::vector<int> orders[] = {
+        none, build_order(PIN_COMPACT), build_order(PIN_SCATTER), build_order(PIN_SMT)
+    };
+    return orders[p];
+}
+
+pin_policy parse_pin_policy(const std::string& s) {
+    if(s == "none") return PIN_NONE;
+    if(s == "compact") return PIN_COMPACT;
+    if(s == "scatter") return PIN_SCATTER;
+    if(s == "smt") return PIN_SMT;
+    throw std::invalid_argument("-pin: expected none, compact, scatter or smt, got '" + s + "'");
+}
+
+const char* pin_policy_name(pin_policy p) {
+    static const char* const names[] = {"none", "compact", "scatter", "smt"};
+    return names[p];
+}
+
+bool pin_thread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
@@ -0,0 +1,40 @@
+/*
+ * affinity.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: CPU placement policies for benchmark threads.
+ *
+ * A policy orders the CPUs this process may run on; benchmark thread i is
+ * pinned to pin_order(policy)[i % size]:
+ *   PIN_COMPACT   one thread per core, filling a socket before the next
+ *   PIN_SCATTER   one thread per core, round robin over the sockets
+ *   PIN_SMT       every hardware thread of a core before the next core
+ * COMPACT and SCATTER only reuse a core's SMT siblings once every core has
+ * a thread. The topology comes from sysfs; without it every CPU is its
+ * own core on socket 0 and all three orders are the plain CPU order.
+ */
+
+#ifndef AFFINITY_H
+#define AFFINITY_H
+
+#include <string>
+#include <vector>
+
+enum pin_policy {
+    PIN_NONE,
+    PIN_COMPACT,
+    PIN_SCATTER,
+    PIN_SMT
+};
+
+/* CPUs in placement order, empty for PIN_NONE */
+const std::vector<int>& pin_order(pin_policy p);
+
+/* "none", "compact", "scatter" or "smt", throws std::invalid_argument */
+pin_policy parse_pin_policy(const std::string& s);
+const char* pin_policy_name(pin_policy p);
+
+/* Bind the calling thread to one CPU, false if the OS refused */
+bool pin_thread(int cpu);
+
+#endif
@@ -0,0 +1,241 @@
+/*
+ * alloc.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Node allocation policies for the lock-free containers.
+ *
+ * An allocator is a stateless policy:
+ *   A::template create<T>(args...)    construct a node
+ *   A::destroy(p)                     destroy it and recycle the memory
+ * A type-stable allocator never returns node memory to the system, so a
+ * stale reader may see a recycled node but never an unmapped one. That is
+ * what lets tagged pointers replace a reclamation scheme.
+ */
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <new>
+#include <cstring>
+#include <cstddef>
+#include <utility>
+#include <mutex>
+#include "tagged_ptr.h"
+#include "stats.h"
+
+/* Plain operator new / delete */
+struct new_alloc {
+    static constexpr const char* name = "new";
+    static const bool type_stable = false;
+
+    template<typename T, typename... Args>
+    static T* create(Args&&... args) {
+        stat_add(STAT_ALLOCS);
+        stat_add(STAT_SYS_ALLOCS);
+        stat_add(STAT_SYS_BYTES, sizeof(T));
+        return new T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    static void destroy(T* p) { delete p; }
+};
+
+/* Global lock-free free list per node type. Blocks are zeroed once when
+   first allocated and are never freed, so fields that are not touched by
+   the node constructor (tags on link words) survive reuse. */
+struct freelist_alloc {
+    static constexpr const char* name = "freelist";
+    static const bool type_stable = true;
+
+    template<typename T>
+    struct pool {
+        /* The link lives outside the node so it cannot clobber node fields.
+           get() reads it from a head that another thread may pop and push
+           back meanwhile; the tagged CAS discards such a read, and the
+           link is atomic so the read is not a data race. */
+        struct block {
+            std::atomic<block*> link;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+        static packed_ptr<block> head;
+
+        static block* of(T* p) {
+            return reinterpret_cast<block*>(
+                reinterpret_cast<unsigned char*>(p) - offsetof(block, storage));
+        }
+
+        static void* get() {
+            tagged<block> h = head.load();
+            while(h.ptr) {
+                if(head.compare_exchange(h, h.ptr->link.load(std::memory_order_relaxed))) return h.ptr->storage;
+            }
+            stat_add(STAT_SYS_ALLOCS);
+            stat_add(STAT_SYS_BYTES, sizeof(block));
+            block* b = static_cast<block*>(::operator new(sizeof(block)));
+            std::memset(static_cast<void*>(b), 0, sizeof(block));
+            return b->storage;
+        }
+
+        static void put(T* p) {
+            block* b = of(p);
+            tagged<block> h = head.load();
+            do {
+                b->link.store(h.ptr, std::memory_order_relaxed);
+            } while(!head.compare_exchange(h, b));
+        }
+    };
+
+    template<typename T, typename... Args>
+    static T* create(Args&&... args) {
+        stat_add(STAT_ALLOCS);
+        return new (pool<T>::get()) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    static void destroy(T* p) {
+        p->~T();
+        pool<T>::put(p);
+    }
+};
+
+template<typename T>
+packed_ptr<typename freelist_alloc::pool<T>::block> freelist_alloc::pool<T>::head{};
+
+/* Per-thread node cache backed by a slab arena. Every block remembers the
+   cache it was carved for; freeing from the owner is a plain list push,
+   freeing from any other thread goes onto the owner's remote list, which
+   the owner takes over in one exchange when its local list runs dry.
+   Caches of exited threads are adopted by new threads, and slabs are
+   never freed, so the allocator is type-stable. */
+struct pool_alloc {
+    static constexpr const char* name = "pool";
+    static const bool type_stable = true;
+    static const int SLAB_NODES = 64;
+
+    template<typename T>
+    struct pool {
+        struct cache;
+        struct block {
+            cache* owner;
+            block* link;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+        struct cache {
+            block* local_free;
+            std::atomic<block*> remote_free;
+            std::atomic<bool> active;
+            cache* next;
+        };
+
+        static std::atomic<cache*> caches;
+
+        static cache* adopt() {
+            for(cache* c = caches.load(); c; c = c->next) {
+                bool expected = false;
+                if(!c->active.load() && c->active.compare_exchange_strong(expected, true))
+                    return c;
+            }
+            cache* c = new cache();
+            c->local_free = nullptr;
+            c->remote_free.store(nullptr);
+            c->active.store(true);
+            cache* old_head = caches.load();
+            do {
+                c->next = old_head;
+            } while(!caches.compare_exchange_weak(old_head, c));
+            return c;
+        }
+
+        /* Reclaimer thread-locals may still allocate and free nodes after
+           this one is gone; a null owner sends those frees down the remote
+           path and those allocations to the shared orphan cache. The
+           pointer lives in a thread-local that is never destroyed, so the
+           null outlasts the teardown. */
+        struct owner_ref {
+            cache*& c;
+            explicit owner_ref(cache*& slot) : c(slot) { c = adopt(); }
+            ~owner_ref() { c->active.store(false); c = nullptr; }
+        };
+
+        static cache* local() {
+            static thread_local cache* c = nullptr;
+            static thread_local owner_ref ref(c);
+            return c;
+        }
+
+        static block* of(T* p) {
+            return reinterpret_cast<block*>(
+                reinterpret_cast<unsigned char*>(p) - offsetof(block, storage));
+        }
+
+        /* Carve a fresh zeroed slab into the local free list */
+        static void refill(cache* c) {
+            std::size_t bytes = sizeof(block) * SLAB_NODES;
+            stat_add(STAT_SYS_ALLOCS);
+            stat_add(STAT_SYS_BYTES, bytes);
+            block* slab = static_cast<block*>(::operator new(bytes));
+            std::memset(static_cast<void*>(slab), 0, bytes);
+            for(int i = 0; i < SLAB_NODES; i++) {
+                slab[i].owner = c;
+                slab[i].link = c->local_free;
+                c->local_free = &slab[i];
+            }
+        }
+
+        /* Owned by no thread and never adopted; get() pops it under a
+           lock, frees to it take the remote path like any other */
+        static cache* orphans() {
+            static cache o{nullptr, {nullptr}, {true}, nullptr};
+            return &o;
+        }
+
+        static void* get() {
+            cache* c = local();
+            if(c) return take(c);
+            static std::mutex lock;
+            std::lock_guard<std::mutex> lk(lock);
+            return take(orphans());
+        }
+
+        static void* take(cache* c) {
+            if(!c->local_free) c->local_free = c->remote_free.exchange(nullptr);
+            if(!c->local_free) refill(c);
+            block* b = c->local_free;
+            c->local_free = b->link;
+            return b->storage;
+        }
+
+        static void put(T* p) {
+            block* b = of(p);
+            cache* c = b->owner;
+            if(c == local()) {
+                b->link = c->local_free;
+                c->local_free = b;
+                return;
+            }
+            /* Remote free: only the owner ever pops, and it takes the whole
+               list at once, so this push cannot suffer ABA */
+            block* old_head = c->remote_free.load();
+            do {
+                b->link = old_head;
+            } while(!c->remote_free.compare_exchange_weak(old_head, b));
+        }
+    };
+
+    template<typename T, typename... Args>
+    static T* create(Args&&... args) {
+        stat_add(STAT_ALLOCS);
+        return new (pool<T>::get()) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    static void destroy(T* p) {
+        p->~T();
+        pool<T>::put(p);
+    }
+};
+
+template<typename T>
+std::atomic<typename pool_alloc::pool<T>::cache*> pool_alloc::pool<T>::caches(nullptr);
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * backoff.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Backoff policies for CAS retry loops and combiner waits.
+ *
+ * A policy is stateless; each operation keeps its own state:
+ *   typename B::state b;       fresh per operation
+ *   b.pause()                  after a failed attempt
+ * Policies that give up the CPU once their delay is capped stay safe on
+ * an oversubscribed host, where a pure spin can starve the thread it is
+ * waiting for.
+ */
+
+#ifndef BACKOFF_H
+#define BACKOFF_H
+
+#include <atomic>
+#include <thread>
+#include "rng.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/* Longest backoff delay in cpu_relax() iterations, and the increment of
+   the proportional policy */
+#define BACKOFF_MAX 1024
+#define BACKOFF_STEP 32
+
+/* Spin-wait hint: lets the sibling hyperthread run and keeps the core
+   from flooding the memory system with speculative loads */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/* Spin for a random count in (limit / 2, limit], so threads that failed
+   together do not retry in lockstep and collide again */
+inline void backoff_spin(int limit) {
+    int spins = limit - (int)thread_rng().below((std::uint32_t)(limit + 1) / 2);
+    for(int i = 0; i < spins; i++) cpu_relax();
+}
+
+/* Retry at once (the original CAS loops) */
+struct no_backoff {
+    static constexpr const char* name = "none";
+    class state {
+    public:
+        void pause() {}
+    };
+};
+
+/* Give up the time slice on every failure (the original FC waiters) */
+struct yield_backoff {
+    static constexpr const char* name = "yield";
+    class state {
+    public:
+        void pause() { std::this_thread::yield(); }
+    };
+};
+
+/* Double the delay bound after every failure, yield once it is capped */
+struct exp_backoff {
+    static constexpr const char* name = "exp";
+    class state {
+        int limit = 1;
+    public:
+        void pause() {
+            backoff_spin(limit);
+            if(limit < BACKOFF_MAX) limit *= 2;
+            else std::this_thread::yield();
+        }
+    };
+};
+
+/* Delay proportional to the number of failures so far, yield once it is
+   capped. Grows more gently than exp_backoff, so a thread that lost a
+   few races is not parked for long after the line has gone quiet. */
+struct prop_backoff {
+    static constexpr const char* name = "proportional";
+    class state {
+        int limit = BACKOFF_STEP;
+    public:
+        void pause() {
+            backoff_spin(limit);
+            if(limit < BACKOFF_MAX) limit += BACKOFF_STEP;
+            else std::this_thread::yield();
+        }
+    };
+};
+
+#endif
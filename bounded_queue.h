@@ -0,0 +1,109 @@
+/*
+ * bounded_queue.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Bounded producer/consumer queue built on a no-spurious condvar.
+ */
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include "containers.h"
+
+template<typename T, typename CondVar>
+bounded_queue<T, CondVar>::bounded_queue(std::size_t capacity, int max_spin)
+    : buffer(new T[pow2_capacity(capacity, 1)]), mask(capacity - 1), head(0), tail(0),
+      not_full(max_spin), not_empty(max_spin) {}
+
+//ADD ITEM
+template<typename T, typename CondVar>
+void bounded_queue<T, CondVar>::enqueue(T&& v) { //Add item to queue
+    std::unique_lock<std::mutex> lk(lock); //Lock the queue
+    while(tail - head == capacity())  //Check if queue is full
+        not_full.wait(lk); //Wait until not full
+
+    buffer[tail++ & mask] = std::move(v);  //add value to buffer, the mask wraps it
+    not_empty.signal(lk); //Unlock, then wake one consumer saying item exists
+}
+
+template<typename T, typename CondVar>
+T bounded_queue<T, CondVar>::dequeue() {
+    std::unique_lock<std::mutex> lk(lock);
+    while(tail == head)
+        not_empty.wait(lk);
+
+    T v = std::move(buffer[head++ & mask]);
+    not_full.signal(lk); //Unlock, then wake one producer
+    return v;
+}
+
+/* Non-blocking dequeue: returns false instead of waiting when empty */
+template<typename T, typename CondVar>
+bool bounded_queue<T, CondVar>::try_dequeue(T& out) {
+    std::unique_lock<std::mutex> lk(lock);
+    if(tail == head) return false;
+
+    out = std::move(buffer[head++ & mask]);
+    not_full.signal(lk); //Unlock, then wake one producer
+    return true;
+}
+
+template<typename T, typename CondVar>
+std::optional<T> bounded_queue<T, CondVar>::try_dequeue() {
+    T v;
+    if(!try_dequeue(v)) return std::nullopt;
+    return v;
+}
+
+/* Bulk enqueue: fill whatever room there is per lock acquisition, then
+   wake the consumers once for the whole run */
+template<typename T, typename CondVar>
+void bounded_queue<T, CondVar>::enqueue_bulk(const T* values, std::size_t n) {
+    while(n > 0) {
+        std::unique_lock<std::mutex> lk(lock);
+        while(tail - head == capacity())
+            not_full.wait(lk);
+
+        std::size_t k = capacity() - (tail - head);
+        if(k > n) k = n;
+        for(std::size_t i = 0; i < k; i++) buffer[tail++ & mask] = values[i];
+        values += k;
+        n -= k;
+        if(k > 1) not_empty.broadcast(lk); //Several items: every sleeper may find one
+        else not_empty.signal(lk);
+    }
+}
+
+//Move up to n items out under the held lock; the callers then wake the
+//producers once for all the slots freed
+template<typename T, typename CondVar>
+std::size_t bounded_queue<T, CondVar>::take(T* out, std::size_t n) {
+    std::size_t k = tail - head;
+    if(k > n) k = n;
+    for(std::size_t i = 0; i < k; i++) out[i] = std::move(buffer[head++ & mask]);
+    return k;
+}
+
+template<typename T, typename CondVar>
+std::size_t bounded_queue<T, CondVar>::dequeue_bulk(T* out, std::size_t n) {
+    std::unique_lock<std::mutex> lk(lock);
+    std::size_t k = take(out, n);
+    if(k > 1) not_full.broadcast(lk);
+    else if(k == 1) not_full.signal(lk);
+    return k;
+}
+
+template<typename T, typename CondVar>
+std::size_t bounded_queue<T, CondVar>::dequeue_bulk_wait(T* out, std::size_t n) {
+    if(n == 0) return 0;
+    std::unique_lock<std::mutex> lk(lock);
+    while(tail == head)
+        not_empty.wait(lk);
+
+    std::size_t k = take(out, n);
+    if(k > 1) not_full.broadcast(lk);
+    else not_full.signal(lk);
+    return k;
+}
+
+#endif
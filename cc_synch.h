@@ -0,0 +1,118 @@
+/*
+ * cc_synch.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: CC-Synch combining - applies any sequential operation on behalf of waiting threads.
+ */
+
+#ifndef CC_SYNCH_H
+#define CC_SYNCH_H
+
+#include "containers.h"
+#include <thread>
+
+/* One request list per node, each starting with a free dummy whose first
+   swapper combines at once */
+template<typename Seq, typename Layout, typename Backoff, typename Topology>
+cc_synch<Seq, Layout, Backoff, Topology>::cc_synch(std::size_t nodes) : domains(nullptr), node_count(nodes), id(next_id.fetch_add(1) + 1) {
+    if(nodes == 0) throw std::invalid_argument("need at least one node");
+    domains = new domain[nodes];
+    for(std::size_t i = 0; i < nodes; i++) {
+        request* dummy = new request();
+        all.push_back(dummy);
+        domains[i].tail.store(dummy);
+    }
+}
+
+/* Destructor: free every request node and handle */
+template<typename Seq, typename Layout, typename Backoff, typename Topology>
+cc_synch<Seq, Layout, Backoff, Topology>::~cc_synch() {
+    for(request* r : all) delete r;
+    for(handle* h : handles) delete h;
+    delete[] domains;
+}
+
+/* Find this thread's handle: the thread-local instance cache covers the
+   common case, even for a thread that alternates between instances (a
+   sharded wrapper over combining shards); only a miss takes the lock and
+   scans the handles */
+template<typename Seq, typename Layout, typename Backoff, typename Topology>
+typename cc_synch<Seq, Layout, Backoff, Topology>::handle* cc_synch<Seq, Layout, Backoff, Topology>::get_handle() {
+    auto& cached = instance_cache<cc_synch, handle*>::of(id);
+    if(cached.id == id) return cached.value;
+
+    std::thread::id me = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lk(handles_lock);
+    handle* h = nullptr;
+    for(handle* x : handles)
+        if(x->owner == me) h = x;
+    if(!h) {
+        h = new handle();
+        h->spare = new request();
+        h->tail = &domains[Topology::node() % node_count].tail;
+        h->owner = me;
+        all.push_back(h->spare);
+        handles.push_back(h);
+    }
+    cached = {id, h};
+    return h;
+}
+
+/* Announce: the spare becomes the new tail, and the old tail, now ours,
+   carries the request. Its wait flag was raised by whoever swapped it in
+   (the dummy's never was), so the spin ends when a combiner has served
+   it or passed the role on. */
+template<typename Seq, typename Layout, typename Backoff, typename Topology>
+void cc_synch<Seq, Layout, Backoff, Topology>::submit(void (*fn)(Seq&, void*), void* arg) {
+    handle* h = get_handle();
+    request* next = h->spare;
+    next->next.store(nullptr, std::memory_order_relaxed);
+    next->completed = false;
+    next->wait.store(true, std::memory_order_relaxed);
+
+    request* r = h->tail->exchange(next, std::memory_order_acq_rel);
+    r->fn = fn;
+    r->arg = arg;
+    r->next.store(next, std::memory_order_release);
+    h->spare = r;
+
+    typename Backoff::state b;
+    while(r->wait.load(std::memory_order_acquire)) b.pause();
+    if(!r->completed) combine(r);
+    if(r->error) std::rethrow_exception(std::exchange(r->error, nullptr));
+}
+
+/* Combiner: serve the list from r onward while the next node is linked,
+   which is what publishes a request, for at most CC_RUN requests. The
+   first request left unserved, or the unannounced tail, gets the role. */
+template<typename Seq, typename Layout, typename Backoff, typename Topology>
+void cc_synch<Seq, Layout, Backoff, Topology>::combine(request* r) {
+    stat_add(STAT_FC_COMBINES);
+    stat_add(STAT_FC_PASSES);
+    std::unique_lock<std::mutex> shared(lock, std::defer_lock);
+    if(node_count > 1) {
+        shared.lock();
+        stat_add(STAT_FC_SHARED);
+    }
+
+    std::size_t served = 0;
+    request* x = r;
+    while(served < CC_RUN) {
+        request* next = x->next.load(std::memory_order_acquire);
+        if(!next) break;
+        try {
+            x->fn(seq, x->arg);
+        } catch(...) {
+            x->error = std::current_exception();
+        }
+        x->completed = true;
+        x->wait.store(false, std::memory_order_release);
+        served++;
+        x = next;
+    }
+    if(shared.owns_lock()) shared.unlock();
+    x->wait.store(false, std::memory_order_release);
+    stat_add(STAT_FC_OPS, served);
+}
+
+#endif
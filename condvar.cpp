@@ -2,10 +2,19 @@
  * condvar.cpp
  * Author: Prudhvi Raj Belide
  *
- * Description: Condition Variable without spurious wakeups (Waking up without being notified).
+ * Description: Condition Variable without spurious wakeups (Waking up without being notified),
+ *              and the eventcount behind the blocking pops of the lock-free containers.
  */
 
 #include "containers.h"
+#include <algorithm>
+#include <climits>
+#include <ctime>
+#ifdef HAVE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 
 /* 
@@ -28,43 +37,197 @@ Checks: epoch != my_epoch → if still 5, go back to sleep
 Only proceeds when epoch ≠ 5 (someone called signal)
 */
 
+/* Spin phase, lock released: watch the epoch for up to spin_limit polls.
+   Returns true if it moved, and adapts the budget either way. */
+template<typename E>
+CONTAINERS_LOCAL bool spin_for_epoch(const std::atomic<E>& epoch, E my_epoch,
+                           std::atomic<int>& spin_limit, int max_spin) {
+    int budget = spin_limit.load(std::memory_order_relaxed);
+    for(int i = 0; i < budget; i++) {
+        if(epoch.load(std::memory_order_acquire) != my_epoch) {
+            if(budget < max_spin)
+                spin_limit.store(std::min(2 * budget, max_spin), std::memory_order_relaxed);
+            return true;
+        }
+    }
+    if(budget > CV_SPIN_MIN)
+        spin_limit.store(std::max(budget / 2, CV_SPIN_MIN), std::memory_order_relaxed);
+    return false;
+}
+
 //Wait does 3 things : Release the lock, Put thread to sleep, When woken, reacquire lock
-void condvar_no_spurious::wait(std::unique_lock<std::mutex>& lock) {
-    std::size_t my_epoch = epoch; //Save current epoch 
-    cv.wait(lock, [&] { return epoch != my_epoch; }); //Sleep until epoch changes
+//A short spin with the lock released comes first, most waits end there
+CONTAINERS_API void condvar_no_spurious::wait(std::unique_lock<std::mutex>& lock) {
+    std::size_t my_epoch = epoch.load(std::memory_order_relaxed); //Save current epoch
+    stat_add(STAT_CV_WAITS);
+    if(max_spin > 0) {
+        lock.unlock();
+        bool moved = spin_for_epoch(epoch, my_epoch, spin_limit, max_spin);
+        lock.lock();
+        if(moved) return;
+    }
+
+    waiters++; //Registered under the lock, so no signal can miss us
+    stat_add(STAT_CV_SLEEPS);
+    cv.wait(lock, [&] { return epoch.load(std::memory_order_relaxed) != my_epoch; }); //Sleep until epoch changes
+    waiters--;
 }
 
-void condvar_no_spurious::signal() {
+//Skip the notify syscall when nobody sleeps
+CONTAINERS_API void condvar_no_spurious::signal() {
     ++epoch;
-    cv.notify_one(); // Wake one thread
+    if(waiters) {
+        stat_add(STAT_CV_WAKEUPS);
+        cv.notify_one(); // Wake one thread
+    }
 }
 
-void condvar_no_spurious::broadcast() {
+CONTAINERS_API void condvar_no_spurious::broadcast() {
     ++epoch;
-    cv.notify_all();
+    if(waiters) {
+        stat_add(STAT_CV_WAKEUPS);
+        cv.notify_all();
+    }
 }
 
-//ADD ITEM
-void bounded_queue::enqueue(int v) { //Add item to queue
-    std::unique_lock<std::mutex> lk(lock); //Lock the queue
-    while(count == SIZE)  //Check if queue is full
-        not_full.wait(lk); //Wait until not full
+//Notify after unlock, so the woken thread does not block on our mutex
+CONTAINERS_API void condvar_no_spurious::signal(std::unique_lock<std::mutex>& lock) {
+    ++epoch;
+    bool sleeping = waiters > 0;
+    lock.unlock();
+    if(sleeping) {
+        stat_add(STAT_CV_WAKEUPS);
+        cv.notify_one();
+    }
+}
 
-    buffer[tail] = v;  //add value to buffer
-    tail = (tail + 1) % SIZE; //Move tail forward (circular buffer)
-    count++;
-    not_empty.signal(); //Wake one consumer saying item exists
+CONTAINERS_API void condvar_no_spurious::broadcast(std::unique_lock<std::mutex>& lock) {
+    ++epoch;
+    bool sleeping = waiters > 0;
+    lock.unlock();
+    if(sleeping) {
+        stat_add(STAT_CV_WAKEUPS);
+        cv.notify_all();
+    }
 }
 
-int bounded_queue::dequeue() {
-    std::unique_lock<std::mutex> lk(lock);
-    while(count == 0)
-        not_empty.wait(lk);
+#ifdef HAVE_FUTEX
+
+CONTAINERS_LOCAL void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected,
+                       const timespec* timeout = nullptr) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE,
+            expected, timeout, nullptr, 0);
+}
+
+CONTAINERS_LOCAL void futex_wake(std::atomic<std::uint32_t>& word, int n) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE,
+            n, nullptr, nullptr, 0);
+}
+
+//The kernel only puts us to sleep if the epoch still holds my_epoch, and a
+//futex return can be spurious, so the epoch is rechecked every time
+CONTAINERS_API void condvar_futex::wait(std::unique_lock<std::mutex>& lock) {
+    std::uint32_t my_epoch = epoch.load(std::memory_order_relaxed);
+    stat_add(STAT_CV_WAITS);
+    lock.unlock();
+    if(max_spin == 0 || !spin_for_epoch(epoch, my_epoch, spin_limit, max_spin)) {
+        stat_add(STAT_CV_SLEEPS);
+        waiters.fetch_add(1);
+        while(epoch.load() == my_epoch)
+            futex_wait(epoch, my_epoch);
+        waiters.fetch_sub(1);
+    }
+    lock.lock();
+}
+
+CONTAINERS_API void condvar_futex::signal() {
+    epoch.fetch_add(1);
+    if(waiters.load()) {
+        stat_add(STAT_CV_WAKEUPS);
+        futex_wake(epoch, 1);
+    }
+}
+
+CONTAINERS_API void condvar_futex::broadcast() {
+    epoch.fetch_add(1);
+    if(waiters.load()) {
+        stat_add(STAT_CV_WAKEUPS);
+        futex_wake(epoch, INT_MAX);
+    }
+}
+
+CONTAINERS_API void condvar_futex::signal(std::unique_lock<std::mutex>& lock) {
+    epoch.fetch_add(1);
+    lock.unlock();
+    if(waiters.load()) {
+        stat_add(STAT_CV_WAKEUPS);
+        futex_wake(epoch, 1);
+    }
+}
+
+CONTAINERS_API void condvar_futex::broadcast(std::unique_lock<std::mutex>& lock) {
+    epoch.fetch_add(1);
+    lock.unlock();
+    if(waiters.load()) {
+        stat_add(STAT_CV_WAKEUPS);
+        futex_wake(epoch, INT_MAX);
+    }
+}
+
+#endif
+
+/* ---------- Eventcount ---------- */
+
+#ifdef HAVE_FUTEX
 
-    int v = buffer[head];
-    head = (head + 1) % SIZE;
-    count--;
+//Same futex over the epoch word; a timed wait sleeps for what is left of
+//the deadline and goes round again after any early return
+CONTAINERS_API bool eventcount::commit_wait(std::uint32_t key, clock::time_point deadline) {
+    bool notified = true;
+    while(epoch.load() == key) {
+        if(deadline == clock::time_point::max()) {
+            futex_wait(epoch, key);
+            continue;
+        }
+        clock::duration left = deadline - clock::now();
+        if(left <= clock::duration::zero()) {
+            notified = false;
+            break;
+        }
+        std::chrono::nanoseconds ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left);
+        timespec ts;
+        ts.tv_sec = (time_t)(ns.count() / 1000000000);
+        ts.tv_nsec = (long)(ns.count() % 1000000000);
+        futex_wait(epoch, key, &ts);
+    }
+    waiters.fetch_sub(1);
+    return notified;
+}
+
+CONTAINERS_API void eventcount::wake(int n) {
+    epoch.fetch_add(1);
+    futex_wake(epoch, n);
+}
+
+#else
 
-    not_full.signal(); //Wake one producer
-    return v;
+//The mutex only orders a sleeper's recheck against the notify, a waker
+//passes through it after the epoch bump so it cannot slip in between
+CONTAINERS_API bool eventcount::commit_wait(std::uint32_t key, clock::time_point deadline) {
+    std::unique_lock<std::mutex> lk(lock);
+    auto moved = [&] { return epoch.load() != key; };
+    bool notified = true;
+    if(deadline == clock::time_point::max()) cv.wait(lk, moved);
+    else notified = cv.wait_until(lk, deadline, moved);
+    waiters.fetch_sub(1);
+    return notified;
+}
+
+CONTAINERS_API void eventcount::wake(int n) {
+    epoch.fetch_add(1);
+    { std::lock_guard<std::mutex> lk(lock); }
+    if(n == 1) cv.notify_one();
+    else cv.notify_all();
 }
+
+#endif
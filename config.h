@@ -0,0 +1,36 @@
+/*
+ * config.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Build mode of the non-template parts of the library.
+ *
+ * The containers are templates and always live in headers. The few
+ * non-template parts (reclamation domains, event counters, condition
+ * variables, topology) are built into libcontainers by default, with
+ * their definitions in .cpp files. Define CONTAINERS_HEADER_ONLY before
+ * the first include, or on the command line, and the headers pull those
+ * .cpp files in themselves with every definition inline, so nothing
+ * needs to be linked. Shared state stays unique per program either way.
+ */
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#ifdef CONTAINERS_HEADER_ONLY
+#define CONTAINERS_API inline           /* library entry points */
+#define CONTAINERS_LOCAL inline         /* file-local helpers and state */
+#else
+#define CONTAINERS_API
+#define CONTAINERS_LOCAL static
+#endif
+
+/* ThreadSanitizer build (gcc defines the macro, clang has the feature) */
+#if defined(__SANITIZE_THREAD__)
+#define CONTAINERS_TSAN 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define CONTAINERS_TSAN 1
+#endif
+#endif
+
+#endif
@@ -3,6 +3,14 @@
  * Author: Prudhvi Raj Belide
  *
  * Description: Header file for all concurrent container classes.
+ *
+ * Every container is a template on its element type T. The member
+ * definitions live in one header per container, included at the end.
+ * Lock-free containers move T into a node and out of it after the
+ * linearizing CAS, so they need T to be nothrow move-constructible and
+ * nothrow move-assignable; the out-parameter forms (try_pop(T&), pop_n)
+ * also need T default-constructible. Bulk inserts copy their input.
+ * Every tuning constant below can be overridden with -D at compile time.
  */
 
 #ifndef CONTAINERS_H
@@ -11,152 +19,1182 @@
 #include <mutex>
 #include <stack>
 #include <queue>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
 #include <atomic>
 #include <vector>
+#include <cstdint>
+#include <optional>
 #include <stdexcept>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include <thread>
 #include <condition_variable>
+#include <exception>
+#include "reclaim.h"
+#include "tagged_ptr.h"
+#include "alloc.h"
+#include "backoff.h"
+#include "eventcount.h"
+#include "numa.h"
+#include "config.h"
 
+#ifndef ELIM_SIZE
 #define ELIM_SIZE 8
-#define MAX_THREADS 32
+#endif
+#ifndef ELIM_SPIN
+#define ELIM_SPIN 128
+#endif
+
+/* Cells per segment of the FAA-array queue */
+#ifndef FAA_SEGMENT
+#define FAA_SEGMENT 1024
+#endif
+
+/* Initial capacity of a work-stealing deque */
+#ifndef WS_CAPACITY
+#define WS_CAPACITY 64
+#endif
+
+/* Default shard count of the relaxed containers */
+#ifndef SHARDS
+#define SHARDS 8
+#endif
+
+/* Failed attempts a blocking ring operation spins before yielding */
+#ifndef RING_SPIN
+#define RING_SPIN 64
+#endif
+
+/* Default capacity of a bounded_queue, a power of two */
+#ifndef BQ_CAPACITY
+#define BQ_CAPACITY 64
+#endif
+
+/* Flat combining: passes per combine, rounds between cleanups, and the
+   number of rounds an idle record may stay in the publication list */
+#ifndef FC_PASSES
+#define FC_PASSES 4
+#endif
+#ifndef FC_CLEANUP_PERIOD
+#define FC_CLEANUP_PERIOD 64
+#endif
+#ifndef FC_MAX_AGE
+#define FC_MAX_AGE 256
+#endif
+
+/* CC-Synch: requests a combiner serves before it hands the role on */
+#ifndef CC_RUN
+#define CC_RUN 64
+#endif
+
+/* Entries per container type in the per-thread caches of per-instance
+   state (combining records and handles, elimination ranges) */
+#ifndef INSTANCE_CACHE
+#define INSTANCE_CACHE 16
+#endif
+
+/* Adaptive stack: ops per sampling window, failed CASes per 100 ops that
+   move it towards or away from combining, the mean combiner batch below
+   which combining is given up, and the publication slots (threads that
+   share a slot fall back to the CAS path) */
+#ifndef ADAPT_WINDOW
+#define ADAPT_WINDOW 1024
+#endif
+#ifndef ADAPT_FAIL_HIGH
+#define ADAPT_FAIL_HIGH 50
+#endif
+#ifndef ADAPT_FAIL_LOW
+#define ADAPT_FAIL_LOW 5
+#endif
+#ifndef ADAPT_BATCH_LOW
+#define ADAPT_BATCH_LOW 2
+#endif
+#ifndef ADAPT_SLOTS
+#define ADAPT_SLOTS 64
+#endif
+
+/* Skiplist priority queue: levels, and the deleted prefix a pop walks
+   before it unlinks the whole prefix */
+#ifndef PQ_LEVELS
+#define PQ_LEVELS 24
+#endif
+#ifndef PQ_BOUND_OFFSET
+#define PQ_BOUND_OFFSET 32
+#endif
+
+/* Hash maps: initial bucket count (a power of two), and the mean items
+   per bucket at which the split-ordered map doubles its buckets */
+#ifndef MAP_BUCKETS
+#define MAP_BUCKETS 16
+#endif
+#ifndef MAP_LOAD
+#define MAP_LOAD 2
+#endif
+
+/* Destructive interference size. std::hardware_destructive_interference_size
+   changes with -mtune (GCC warns when it is used in a header), so the
+   layout is pinned to the common 64-byte line instead. */
+#ifndef CACHE_LINE
+#define CACHE_LINE 64
+#endif
+
+/* Layout policies: padded keeps every hot word and per-thread record on
+   its own cache line, packed keeps natural alignment (old behaviour) */
+struct padded_layout {
+    static constexpr const char* name = "padded";
+    static const std::size_t ALIGN = CACHE_LINE;
+};
+
+struct packed_layout {
+    static constexpr const char* name = "packed";
+    static const std::size_t ALIGN = 1;
+};
+
+/* Alignment for a hot member under Layout, never weaker than T's own */
+#define LAYOUT_ALIGN(Layout, T) \
+    alignas(Layout::ALIGN > alignof(T) ? Layout::ALIGN : alignof(T))
+
+/* Small trivially-copyable values travel by value through publication
+   records and exchange slots; anything else goes by address */
+template<typename T>
+struct inline_value : std::integral_constant<bool,
+    std::is_trivially_copyable<T>::value && sizeof(T) <= 2 * sizeof(void*)> {};
+
+/* Value carried by a publication record. An inline value is copied into
+   the record; anything else stays in the caller's object, which outlives
+   the request, and the record only holds its address.
+     owner:    send(v) an argument, expect(out) a result,
+               receive(out) once the request has completed
+     combiner: get() the argument, put(v) the result */
+template<typename T, bool Inline = inline_value<T>::value>
+class value_slot {
+    alignas(T) unsigned char buf[sizeof(T)];
+public:
+    void send(T& v) { std::memcpy(buf, &v, sizeof(T)); }
+    void expect(T&) {}
+    void receive(T& out) { std::memcpy(&out, buf, sizeof(T)); }
+    T& get() { return *reinterpret_cast<T*>(buf); }
+    void put(T&& v) { std::memcpy(buf, &v, sizeof(T)); }
+};
+
+template<typename T>
+class value_slot<T, false> {
+    T* ref;
+public:
+    void send(T& v) { ref = &v; }
+    void expect(T& out) { ref = &out; }
+    void receive(T&) {}
+    T& get() { return *ref; }
+    void put(T&& v) { *ref = std::move(v); }
+};
 
 /* Single global lock stack */
+template<typename T>
 class sgl_stack {
-    std::stack<int> data;
+    std::stack<T> data;
     std::mutex lock;
 public:
-    void push(int value);
-    int pop();
+    typedef T value_type;
+    void push(const T& value);
+    void push(T&& value);
+    template<typename... Args> void emplace(Args&&... args);
+    T pop();
+    bool try_pop(T& out);
+    std::optional<T> try_pop();
+    void push_n(const T* values, std::size_t n);
+    std::size_t pop_n(T* out, std::size_t n);
 };
 
 /* Single global lock queue */
+template<typename T>
 class sgl_queue {
-    std::queue<int> data;
+    std::queue<T> data;
     std::mutex lock;
 public:
-    void enqueue(int value);
-    int dequeue();
+    typedef T value_type;
+    void enqueue(const T& value);
+    void enqueue(T&& value);
+    template<typename... Args> void emplace(Args&&... args);
+    T dequeue();
+    bool try_dequeue(T& out);
+    std::optional<T> try_dequeue();
+    void enqueue_bulk(const T* values, std::size_t n);
+    std::size_t dequeue_bulk(T* out, std::size_t n);
+};
+
+/* Reuse without reclamation needs versioned pointers and stable memory */
+#define CHECK_POLICIES(Reclaim, PtrT, Alloc) \
+    static_assert(!Reclaim::immediate || (PtrT::is_tagged && Alloc::type_stable), \
+                  "immediate_reclaim needs a tagged pointer and a type-stable allocator")
+
+/* A value moved out after the linearizing CAS cannot be handed back */
+#define CHECK_VALUE(T) \
+    static_assert(std::is_nothrow_move_constructible<T>::value && \
+                  std::is_nothrow_move_assignable<T>::value, \
+                  "lock-free containers need a nothrow-movable T")
+
+/* Per-thread state a thread keeps for each instance of Owner, found
+   without a lock. Owner hands out ids from 1 in sequence and never
+   reuses them, so up to INSTANCE_CACHE instances used side by side get
+   an entry each (direct mapped on the id), and an entry left over from
+   a destroyed instance can never match. */
+template<typename Owner, typename V>
+struct instance_cache {
+    struct entry { std::uint64_t id; V value; };
+    static entry& of(std::uint64_t id) {
+        static thread_local entry cache[INSTANCE_CACHE] = {};
+        return cache[id % INSTANCE_CACHE];
+    }
 };
 
 /* Treiber lock-free stack */
+template<typename T,
+         typename Reclaim = hazard_pointers,
+         template<typename> class Ptr = plain_ptr,
+         typename Alloc = new_alloc,
+         typename Layout = padded_layout,
+         typename Backoff = exp_backoff>
 class treiber_stack {
     struct node {
-        int value;
-        node* next;
-        node(int v) : value(v), next(nullptr) {}
+        T value;
+        std::atomic<node*> next;    /* pops read it speculatively, see pop_n */
+        template<typename... Args>
+        explicit node(Args&&... args) : value(std::forward<Args>(args)...) {}
     };
-    std::atomic<node*> top;
+    LAYOUT_ALIGN(Layout, Ptr<node>) Ptr<node> top{};
+    static void free_node(void* p) { Alloc::destroy(static_cast<node*>(p)); }
+    void link(node* first, node* last);
+    LAYOUT_ALIGN(Layout, eventcount) eventcount nonempty;   /* sleeping pop_wait()ers */
+    CHECK_POLICIES(Reclaim, Ptr<node>, Alloc);
+    CHECK_VALUE(T);
 public:
-    treiber_stack() : top(nullptr) {}
+    typedef T value_type;
+    treiber_stack() { top.store(nullptr); }
     ~treiber_stack();
-    void push(int value);
-    int pop();
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+    template<typename... Args> void emplace(Args&&... args);
+    T pop();
+    bool try_pop(T& out);
+    std::optional<T> try_pop();
+    T pop_wait();
+    template<typename Rep, typename Period>
+    std::optional<T> pop_for(const std::chrono::duration<Rep, Period>& timeout);
+    void push_n(const T* values, std::size_t n);
+    std::size_t pop_n(T* out, std::size_t n);
 };
 
-/* Michael & Scott lock-free queue */
+/* Michael & Scott lock-free queue. The value lives in raw node storage
+   because the dummy node has none. A trivially-copyable value is copied
+   out before the CAS as in the paper; anything else is moved out after
+   it, from the node that just became the dummy, which needs a real
+   reclamation scheme to keep that node alive. */
+template<typename T,
+         typename Reclaim = hazard_pointers,
+         template<typename> class Ptr = plain_ptr,
+         typename Alloc = new_alloc,
+         typename Layout = padded_layout,
+         typename Backoff = exp_backoff>
 class msqueue {
     struct node {
-        int value;
-        std::atomic<node*> next;
-        node(int v) : value(v), next(nullptr) {}
+        Ptr<node> next;     /* left untouched so its tag survives reuse */
+        alignas(T) unsigned char storage[sizeof(T)];
+        node() {}
+        template<typename... Args>
+        explicit node(std::in_place_t, Args&&... args) {
+            new (storage) T(std::forward<Args>(args)...);
+        }
+        T* val() { return reinterpret_cast<T*>(storage); }
     };
-    std::atomic<node*> head;
-    std::atomic<node*> tail;
+    LAYOUT_ALIGN(Layout, Ptr<node>) Ptr<node> head{};
+    LAYOUT_ALIGN(Layout, Ptr<node>) Ptr<node> tail{};
+    static void free_node(void* p) { Alloc::destroy(static_cast<node*>(p)); }
+    void append(node* first, node* last);
+    LAYOUT_ALIGN(Layout, eventcount) eventcount nonempty;   /* sleeping dequeue_wait()ers */
+    CHECK_POLICIES(Reclaim, Ptr<node>, Alloc);
+    CHECK_VALUE(T);
+    static_assert(!Reclaim::immediate || std::is_trivially_copyable<T>::value,
+                  "immediate_reclaim can only copy values out before the CAS");
 public:
+    typedef T value_type;
     msqueue();
     ~msqueue();
-    void enqueue(int value);
-    int dequeue();
+    void enqueue(const T& value) { emplace(value); }
+    void enqueue(T&& value) { emplace(std::move(value)); }
+    template<typename... Args> void emplace(Args&&... args);
+    T dequeue();
+    bool try_dequeue(T& out);
+    std::optional<T> try_dequeue();
+    T dequeue_wait();
+    template<typename Rep, typename Period>
+    std::optional<T> dequeue_for(const std::chrono::duration<Rep, Period>& timeout);
+    void enqueue_bulk(const T* values, std::size_t n);
+    std::size_t dequeue_bulk(T* out, std::size_t n);
+};
+
+/* FAA-array queue (Ramalhete & Correia 2016): a linked list of segments,
+   each an array of cells claimed with fetch_add on the segment's enqueue
+   and dequeue indices. An operation is one FAA plus one CAS or exchange
+   on its own cell; head and tail only move once per FAA_SEGMENT items.
+   A dequeuer that reaches a cell before its enqueuer marks it taken, and
+   the enqueuer retries with a fresh index. Values live in the cells, so
+   there is no node per element. */
+template<typename T,
+         typename Reclaim = hazard_pointers,
+         typename Alloc = new_alloc,
+         typename Layout = padded_layout>
+class faa_queue {
+    static const int CELL_EMPTY = 0, CELL_FULL = 1, CELL_TAKEN = 2;
+    struct cell {
+        std::atomic<int> state;
+        alignas(T) unsigned char storage[sizeof(T)];
+        T* val() { return reinterpret_cast<T*>(storage); }
+    };
+    struct segment {
+        LAYOUT_ALIGN(Layout, std::atomic<std::size_t>) std::atomic<std::size_t> enq_idx;
+        LAYOUT_ALIGN(Layout, std::atomic<std::size_t>) std::atomic<std::size_t> deq_idx;
+        LAYOUT_ALIGN(Layout, std::atomic<segment*>) std::atomic<segment*> next;
+        cell cells[FAA_SEGMENT];
+        segment();
+    };
+    LAYOUT_ALIGN(Layout, std::atomic<segment*>) std::atomic<segment*> head;
+    LAYOUT_ALIGN(Layout, std::atomic<segment*>) std::atomic<segment*> tail;
+    static void free_segment(void* p) { Alloc::destroy(static_cast<segment*>(p)); }
+    void put(T& v);
+    LAYOUT_ALIGN(Layout, eventcount) eventcount nonempty;   /* sleeping dequeue_wait()ers */
+    CHECK_POLICIES(Reclaim, plain_ptr<segment>, Alloc);
+    CHECK_VALUE(T);
+public:
+    typedef T value_type;
+    faa_queue();
+    ~faa_queue();
+    void enqueue(const T& value) { emplace(value); }
+    void enqueue(T&& value) { emplace(std::move(value)); }
+    template<typename... Args> void emplace(Args&&... args);
+    T dequeue();
+    bool try_dequeue(T& out);
+    std::optional<T> try_dequeue();
+    T dequeue_wait();
+    template<typename Rep, typename Period>
+    std::optional<T> dequeue_for(const std::chrono::duration<Rep, Period>& timeout);
+    void enqueue_bulk(const T* values, std::size_t n);
+    std::size_t dequeue_bulk(T* out, std::size_t n);
+};
+
+/* Collision array: a push hands its node straight to a concurrent pop
+   through one of ELIM_SIZE slots, so neither touches the stack top.
+   Each slot word is (tag << 48) | node pointer | state, the tag is bumped
+   on every change so a recycled node address cannot be mistaken for the
+   op that published it. */
+template<typename Layout>
+class elimination_array {
+    struct LAYOUT_ALIGN(Layout, std::atomic<std::uint64_t>) elim_slot {
+        std::atomic<std::uint64_t> word{0};
+    };
+    elim_slot slots[ELIM_SIZE];
+    const std::uint64_t id;
+
+    static std::atomic<std::uint64_t> next_id;
+    int& range();
+public:
+    elimination_array() : id(next_id.fetch_add(1) + 1) {}
+    bool exchange_push(void* n);        /* true if a pop took n */
+    void* exchange_pop();               /* a pushed node, or null */
 };
 
-/* Elimination stack with collision array */
+template<typename Layout>
+std::atomic<std::uint64_t> elimination_array<Layout>::next_id(0);
+
+/* Elimination stack: a Treiber stack that falls back to the collision
+   array after a failed CAS */
+template<typename T,
+         typename Reclaim = hazard_pointers,
+         template<typename> class Ptr = plain_ptr,
+         typename Alloc = new_alloc,
+         typename Layout = padded_layout,
+         typename Backoff = exp_backoff>
 class elimination_stack {
     struct node {
-        int value;
-        node* next;
-        node(int v) : value(v), next(nullptr) {}
-    };
-    std::atomic<node*> top;
-    std::atomic<int> elim_ops[ELIM_SIZE];
-    std::atomic<int> elim_vals[ELIM_SIZE];
-public:
-    elimination_stack() : top(nullptr) {
-        for(int i = 0; i < ELIM_SIZE; i++) {
-            elim_ops[i] = 0;
-            elim_vals[i] = 0;
-        }
-    }
+        T value;
+        std::atomic<node*> next;    /* pops read it speculatively, see pop_n */
+        template<typename... Args>
+        explicit node(Args&&... args) : value(std::forward<Args>(args)...) {}
+    };
+    LAYOUT_ALIGN(Layout, Ptr<node>) Ptr<node> top{};
+    elimination_array<Layout> elim;
+    static void free_node(void* p) { Alloc::destroy(static_cast<node*>(p)); }
+    LAYOUT_ALIGN(Layout, eventcount) eventcount nonempty;   /* sleeping pop_wait()ers */
+    CHECK_POLICIES(Reclaim, Ptr<node>, Alloc);
+    CHECK_VALUE(T);
+public:
+    typedef T value_type;
+    elimination_stack() { top.store(nullptr); }
     ~elimination_stack();
-    void push(int value);
-    int pop();
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+    template<typename... Args> void emplace(Args&&... args);
+    T pop();
+    bool try_pop(T& out);
+    std::optional<T> try_pop();
+    T pop_wait();
+    template<typename Rep, typename Period>
+    std::optional<T> pop_for(const std::chrono::duration<Rep, Period>& timeout);
+    void push_n(const T* values, std::size_t n);
+    std::size_t pop_n(T* out, std::size_t n);
 };
 
-/* Flat combining stack */
+/* How an adaptive_stack reaches its list, in order of rising contention */
+enum adapt_mode { ADAPT_TREIBER, ADAPT_ELIMINATION, ADAPT_COMBINING };
+
+/* Adaptive stack: one Treiber node list reached three ways. TREIBER
+   retries its CAS with backoff, ELIMINATION offers the op to a collision
+   array after a failed CAS, COMBINING publishes it in a slot for whoever
+   holds the combiner lock, which pairs pushes with pops and splices the
+   remaining pushes in with one CAS. Every path linearizes on a CAS of the
+   same top or on the pairing of two pending ops, so the mode can change
+   at any time: ops still running under the old mode stay correct and
+   there is nothing to hand over. Threads sample their own failed CASes
+   over ADAPT_WINDOW ops to move the mode up or down; the combiner moves
+   it down when its batches stay small. */
+template<typename T,
+         typename Reclaim = hazard_pointers,
+         template<typename> class Ptr = plain_ptr,
+         typename Alloc = new_alloc,
+         typename Layout = padded_layout,
+         typename Backoff = exp_backoff>
+class adaptive_stack {
+    struct node {
+        T value;
+        std::atomic<node*> next;    /* pops read it speculatively, see pop_n */
+        template<typename... Args>
+        explicit node(Args&&... args) : value(std::forward<Args>(args)...) {}
+    };
+
+    /* Publication slot of the threads with thread_index() % ADAPT_SLOTS.
+       The owner claims it, sets n and releases op; the combiner writes the
+       result and resets op to 0. ops and fails are the owner's window. */
+    struct LAYOUT_ALIGN(Layout, std::atomic<int>) slot {
+        std::atomic<bool> claimed{false};
+        std::atomic<int> op{0};         /* 1 push, 2 pop, 0 done */
+        node* n = nullptr;              /* push: node to link, pop: result or null */
+        bool listed = false;            /* result came off the list, retire it */
+        std::atomic<unsigned> ops{0}, fails{0};
+    };
+
+    LAYOUT_ALIGN(Layout, Ptr<node>) Ptr<node> top{};
+    LAYOUT_ALIGN(Layout, std::atomic<int>) std::atomic<int> current;
+    elimination_array<Layout> elim;
+    LAYOUT_ALIGN(Layout, std::mutex) std::mutex combiner;
+    unsigned passes = 0, served = 0;    /* combiner window, guarded by combiner */
+    slot slots[ADAPT_SLOTS];
+    std::atomic<std::size_t> slots_used{0};
+    LAYOUT_ALIGN(Layout, eventcount) eventcount nonempty;   /* sleeping pop_wait()ers */
+
+    static void free_node(void* p) { Alloc::destroy(static_cast<node*>(p)); }
+    slot& my_slot();
+    void sample(slot& s, unsigned fails);
+    void shift(int from, int to);
+    void push_node(node* n);
+    bool pop_one(T& out);
+    bool publish(slot& s, int op, node*& n, bool& listed, typename Reclaim::guard& g);
+    void combine(typename Reclaim::guard& g);
+    CHECK_POLICIES(Reclaim, Ptr<node>, Alloc);
+    CHECK_VALUE(T);
+public:
+    typedef T value_type;
+    explicit adaptive_stack(adapt_mode start = ADAPT_TREIBER) : current(start) { top.store(nullptr); }
+    ~adaptive_stack();
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+    template<typename... Args> void emplace(Args&&... args);
+    T pop();
+    bool try_pop(T& out) { return pop_one(out); }
+    std::optional<T> try_pop();
+    T pop_wait();
+    template<typename Rep, typename Period>
+    std::optional<T> pop_for(const std::chrono::duration<Rep, Period>& timeout);
+    void push_n(const T* values, std::size_t n);
+    std::size_t pop_n(T* out, std::size_t n);
+    adapt_mode mode() const { return (adapt_mode)current.load(std::memory_order_relaxed); }
+};
+
+/* Flat combining stack, hierarchical over the nodes of Topology: each node
+   has its own publication list and combiner, and a node combiner pairs
+   pushes with pops locally before taking the stack-wide lock for what is
+   left. With one node that lock is never taken. */
+template<typename T, typename Layout = padded_layout, typename Backoff = exp_backoff,
+         typename Topology = flat_topology>
 class fc_stack {
-    std::stack<int> data;
-    std::mutex lock;
-    struct slot {
-        std::atomic<int> op;
-        std::atomic<int> val;
-        std::atomic<int> result;
-        std::atomic<bool> done;
-    } slots[MAX_THREADS];
-    int get_slot();
-    void combine();
-public:
-    fc_stack() {
-        for(int i = 0; i < MAX_THREADS; i++) {
-            slots[i].op = 0;
-            slots[i].done = false;
-        }
+    std::vector<T> data;                /* contiguous storage, top at back */
+    LAYOUT_ALIGN(Layout, std::mutex) std::mutex lock;   /* data, with more than one node */
+
+    struct domain;
+
+    /* Publication record, one per thread and container. The owner writes
+       val (or the span) and releases op, the combiner writes result and
+       resets op to 0, which is the completion signal. */
+    struct LAYOUT_ALIGN(Layout, std::atomic<int>) record {
+        std::atomic<int> op;            /* 1/2 single, 3/4 bulk over span */
+        value_slot<T> val;
+        value_slot<T> result;
+        bool ok;                        /* single removal found an item */
+        const T* span_in;
+        T* span_out;
+        std::size_t span_n;             /* bulk removals: count on return */
+        std::atomic<bool> active;       /* linked into the publication list */
+        unsigned age;                   /* combine round that last served it */
+        record* next;
+        domain* home;                   /* node whose combiner serves it */
+        std::thread::id owner;
+    };
+
+    /* Per-node publication list and combiner */
+    struct LAYOUT_ALIGN(Layout, std::mutex) domain {
+        std::mutex lock;                /* held by the node's combiner */
+        LAYOUT_ALIGN(Layout, std::atomic<record*>) std::atomic<record*> pub_head{nullptr};
+        unsigned rounds = 0;            /* combine rounds, guarded by lock */
+        std::vector<record*> pushes, pops, bulks;   /* combiner scratch, one pass */
+    };
+    domain* domains;
+    const std::size_t node_count;
+    const std::uint64_t id;
+    std::vector<record*> records;       /* every record ever handed out */
+    std::mutex records_lock;
+
+    static std::atomic<std::uint64_t> next_id;
+    record* get_record();
+    void enlist(record* r);
+    void combine(domain& d);
+    void cleanup(domain& d);
+    void wait_for(record* r);
+public:
+    typedef T value_type;
+    explicit fc_stack(std::size_t nodes = Topology::nodes());
+    ~fc_stack();
+    void push(const T& value) { T v(value); push(std::move(v)); }
+    void push(T&& value);
+    template<typename... Args> void emplace(Args&&... args) { push(T(std::forward<Args>(args)...)); }
+    T pop();
+    bool try_pop(T& out);
+    std::optional<T> try_pop();
+    void push_n(const T* values, std::size_t n);
+    std::size_t pop_n(T* out, std::size_t n);
+    std::size_t nodes() const { return node_count; }
+};
+
+template<typename T, typename Layout, typename Backoff, typename Topology>
+std::atomic<std::uint64_t> fc_stack<T, Layout, Backoff, Topology>::next_id(0);
+
+/* Sequential stores a combiner applies requests to: push, empty, and
+   take, which removes and returns the next item */
+template<typename T>
+class fifo_store {
+    std::queue<T> q;
+public:
+    void push(T&& v) { q.push(std::move(v)); }
+    void push(const T& v) { q.push(v); }
+    bool empty() const { return q.empty(); }
+    T take() { T v = std::move(q.front()); q.pop(); return v; }
+};
+
+/* Binary min-heap by Compare: take returns the least item. The std heap
+   algorithms keep the greatest at the front, so they get the reversed
+   comparison. */
+template<typename T, typename Compare = std::less<T>>
+class heap_store {
+    struct reversed {
+        Compare less;
+        bool operator()(const T& a, const T& b) const { return less(b, a); }
+    };
+    std::vector<T> v;
+public:
+    void push(T&& x) { v.push_back(std::move(x)); std::push_heap(v.begin(), v.end(), reversed()); }
+    void push(const T& x) { v.push_back(x); std::push_heap(v.begin(), v.end(), reversed()); }
+    bool empty() const { return v.empty(); }
+    T take() {
+        std::pop_heap(v.begin(), v.end(), reversed());
+        T x = std::move(v.back());
+        v.pop_back();
+        return x;
     }
-    void push(int value);
-    int pop();
 };
 
-/* Flat combining queue */
-class fc_queue {
-    std::queue<int> data;
-    std::mutex lock;
-    struct slot {
-        std::atomic<int> op;
-        std::atomic<int> val;
-        std::atomic<int> result;
-        std::atomic<bool> done;
-    } slots[MAX_THREADS];
-    int get_slot();
-    void combine();
-public:
-    fc_queue() {
-        for(int i = 0; i < MAX_THREADS; i++) {
-            slots[i].op = 0;
-            slots[i].done = false;
-        }
+/* CC-Synch combining (Fatourou & Kallimanis 2012), hierarchical over the
+   nodes of Topology as in their H-Synch. A thread announces a request by
+   swapping its spare node in as the tail of its node's request list, then
+   spins on the flag of the node it got back, which nobody else polls. The
+   thread whose flag drops without its request done is the combiner: it
+   applies up to CC_RUN requests to seq in list order and hands the role
+   to the next waiter. With more than one node a combiner holds the shared
+   lock for its run; with one it is never taken.
+   execute(f) runs f(seq) exactly once, on some thread, while no other
+   request runs; an exception from f is rethrown to its caller. */
+template<typename Seq, typename Layout = padded_layout, typename Backoff = exp_backoff,
+         typename Topology = flat_topology>
+class cc_synch {
+    /* The node is the request of whoever swapped it out of the tail. Its
+       owner writes fn and arg, then next; the combiner writes completed
+       and error, then drops wait. */
+    struct LAYOUT_ALIGN(Layout, std::atomic<bool>) request {
+        std::atomic<bool> wait{false};
+        bool completed = false;
+        void (*fn)(Seq&, void*) = nullptr;
+        void* arg = nullptr;
+        std::exception_ptr error;
+        std::atomic<request*> next{nullptr};
+    };
+
+    /* A thread's spare node, a different one after every request */
+    struct handle {
+        request* spare;
+        std::atomic<request*>* tail;    /* request list of its node */
+        std::thread::id owner;
+    };
+
+    struct LAYOUT_ALIGN(Layout, std::atomic<request*>) domain {
+        std::atomic<request*> tail;
+    };
+
+    Seq seq;
+    LAYOUT_ALIGN(Layout, std::mutex) std::mutex lock;   /* seq, with more than one node */
+    domain* domains;
+    const std::size_t node_count;
+    const std::uint64_t id;
+    std::vector<handle*> handles;       /* every thread that ever executed */
+    std::vector<request*> all;          /* every request node, to free */
+    std::mutex handles_lock;
+
+    static std::atomic<std::uint64_t> next_id;
+    template<typename F>
+    static void call(Seq& s, void* f) { (*static_cast<F*>(f))(s); }
+    handle* get_handle();
+    void submit(void (*fn)(Seq&, void*), void* arg);
+    void combine(request* r);
+public:
+    explicit cc_synch(std::size_t nodes = Topology::nodes());
+    ~cc_synch();
+    cc_synch(const cc_synch&) = delete;
+    cc_synch& operator=(const cc_synch&) = delete;
+    template<typename F>
+    void execute(F&& f) {
+        typedef typename std::remove_reference<F>::type fn_type;
+        submit(&call<fn_type>, const_cast<void*>(static_cast<const void*>(std::addressof(f))));
     }
-    void enqueue(int value);
-    int dequeue();
+    std::size_t nodes() const { return node_count; }
 };
 
-/* Condition variable without spurious wakeups */
+template<typename Seq, typename Layout, typename Backoff, typename Topology>
+std::atomic<std::uint64_t> cc_synch<Seq, Layout, Backoff, Topology>::next_id(0);
+
+/* Combining queue, a thin wrapper that runs every operation on Store
+   through cc_synch; with more than one node the node combiners take
+   turns on the shared store. Store decides the order items leave in. */
+template<typename T, typename Layout = padded_layout, typename Backoff = exp_backoff,
+         typename Topology = flat_topology, typename Store = fifo_store<T>>
+class fc_queue {
+    cc_synch<Store, Layout, Backoff, Topology> sync;
+public:
+    typedef T value_type;
+    explicit fc_queue(std::size_t nodes = Topology::nodes()) : sync(nodes) {}
+    void enqueue(const T& value) { T v(value); enqueue(std::move(v)); }
+    void enqueue(T&& value);
+    template<typename... Args> void emplace(Args&&... args) { enqueue(T(std::forward<Args>(args)...)); }
+    T dequeue();
+    bool try_dequeue(T& out);
+    std::optional<T> try_dequeue();
+    void enqueue_bulk(const T* values, std::size_t n);
+    std::size_t dequeue_bulk(T* out, std::size_t n);
+    std::size_t nodes() const { return sync.nodes(); }
+};
+
+/* Combining min-priority queue: the combining queue over a binary
+   heap, with the push/pop names of the other priority queue */
+template<typename T, typename Compare = std::less<T>, typename Layout = padded_layout,
+         typename Backoff = exp_backoff, typename Topology = flat_topology>
+class fc_heap : private fc_queue<T, Layout, Backoff, Topology, heap_store<T, Compare>> {
+    typedef fc_queue<T, Layout, Backoff, Topology, heap_store<T, Compare>> base;
+public:
+    typedef T value_type;
+    explicit fc_heap(std::size_t nodes = Topology::nodes()) : base(nodes) {}
+    void push(const T& value) { base::enqueue(value); }
+    void push(T&& value) { base::enqueue(std::move(value)); }
+    using base::emplace;
+    T pop() { return base::dequeue(); }
+    bool try_pop(T& out) { return base::try_dequeue(out); }
+    std::optional<T> try_pop() { return base::try_dequeue(); }
+    void push_n(const T* values, std::size_t n) { base::enqueue_bulk(values, n); }
+    std::size_t pop_n(T* out, std::size_t n) { return base::dequeue_bulk(out, n); }
+    using base::nodes;
+};
+
+/* Lock-free skiplist min-priority queue (Linden & Jonsson 2013). pop
+   claims the first live node on the bottom level by setting the delete
+   bit in its predecessor's next[0], so the deleted nodes always form a
+   prefix of the list; once a pop walked past PQ_BOUND_OFFSET of them it
+   swings head past the whole prefix with one CAS and retires it. Pushes
+   link in after the prefix. Nodes are read while other threads delete
+   them, so pop copies the value out (T must be copyable) and reclamation
+   is epoch-based: a traversal holds unboundedly many nodes, more than
+   hazard pointers can publish. */
+template<typename T, typename Compare = std::less<T>>
+class skiplist_pq {
+    struct node {
+        alignas(T) unsigned char storage[sizeof(T)];
+        std::atomic<std::uintptr_t>* next;  /* height links, allocated behind the node */
+        int height;
+        std::atomic<bool> inserting;        /* upper levels still being linked */
+        T* val() { return reinterpret_cast<T*>(storage); }
+    };
+    static node* ref(std::uintptr_t w) { return reinterpret_cast<node*>(w & ~(std::uintptr_t)1); }
+    static bool marked(std::uintptr_t w) { return w & 1; }
+    static std::uintptr_t word(node* n, bool mark = false) { return reinterpret_cast<std::uintptr_t>(n) | mark; }
+
+    node* const head;                       /* no value, PQ_LEVELS links */
+    Compare less;
+
+    static node* alloc_node(int height);
+    static void free_node(void* p);
+    static int random_height();
+    node* locate_preds(const T& key, node** preds, node** succs);
+    void restructure();
+    CHECK_VALUE(T);
+    static_assert(std::is_copy_constructible<T>::value && std::is_copy_assignable<T>::value,
+                  "skiplist_pq copies values out, T must be copyable");
+public:
+    typedef T value_type;
+    skiplist_pq() : head(alloc_node(PQ_LEVELS)) {}
+    ~skiplist_pq();
+    skiplist_pq(const skiplist_pq&) = delete;
+    skiplist_pq& operator=(const skiplist_pq&) = delete;
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+    template<typename... Args> void emplace(Args&&... args);
+    T pop();
+    bool try_pop(T& out);
+    std::optional<T> try_pop();
+    void push_n(const T* values, std::size_t n);
+    std::size_t pop_n(T* out, std::size_t n);
+};
+
+/* Adaptive spin before a condvar wait sleeps: the budget doubles after a
+   spin that saw the signal and halves after one that did not, within
+   [CV_SPIN_MIN, max_spin] */
+#define CV_SPIN_MIN 16
+#define CV_SPIN_MAX 4096
+
+/* Condition variable without spurious wakeups. signal() and broadcast()
+   are called with the mutex held; the lock-taking forms bump the epoch,
+   release the lock and only then notify, and only if anyone sleeps. */
 struct condvar_no_spurious {
+    static constexpr const char* name = "std";
+
     std::condition_variable cv;
-    std::size_t epoch = 0;
+    std::atomic<std::size_t> epoch{0};
+    int waiters = 0;                    /* sleepers, guarded by the mutex */
+    const int max_spin;
+    std::atomic<int> spin_limit;
 
+    explicit condvar_no_spurious(int max_spin = CV_SPIN_MAX)
+        : max_spin(max_spin), spin_limit(max_spin < CV_SPIN_MIN ? max_spin : CV_SPIN_MIN) {}
     void wait(std::unique_lock<std::mutex>& lock);
     void signal();
     void broadcast();
+    void signal(std::unique_lock<std::mutex>& lock);
+    void broadcast(std::unique_lock<std::mutex>& lock);
 };
 
-/* Bounded queue using condition variables */
+#ifdef HAVE_FUTEX
+/* Same interface on a raw futex over the epoch word. The waiter count is
+   atomic so a signal needs no lock to see it: a waiter registers before
+   it rechecks the epoch and a signaler bumps the epoch before it reads
+   the count, so one of them always sees the other. */
+struct condvar_futex {
+    static constexpr const char* name = "futex";
+
+    std::atomic<std::uint32_t> epoch{0};
+    std::atomic<int> waiters{0};
+    const int max_spin;
+    std::atomic<int> spin_limit;
+
+    explicit condvar_futex(int max_spin = CV_SPIN_MAX)
+        : max_spin(max_spin), spin_limit(max_spin < CV_SPIN_MIN ? max_spin : CV_SPIN_MIN) {}
+    void wait(std::unique_lock<std::mutex>& lock);
+    void signal();
+    void broadcast();
+    void signal(std::unique_lock<std::mutex>& lock);
+    void broadcast(std::unique_lock<std::mutex>& lock);
+};
+#endif
+
+/* Bounded queue using condition variables (T default-constructible).
+   The capacity is a power of two set at run time, head and tail run
+   free and are masked into the buffer. max_spin is handed to both
+   condition variables, 0 sleeps at once. The bulk forms move a whole run
+   under one lock acquisition and wake the other side once per run. */
+template<typename T, typename CondVar = condvar_no_spurious>
 class bounded_queue {
-    static const int SIZE = 50;
-    int buffer[SIZE];
-    int head, tail, count;
+    T* const buffer;
+    const std::size_t mask;
+    std::size_t head, tail;             /* tail - head items are in the buffer */
+    std::mutex lock;
+    CondVar not_full, not_empty;
+    std::size_t take(T* out, std::size_t n);
+public:
+    typedef T value_type;
+    explicit bounded_queue(std::size_t capacity = BQ_CAPACITY, int max_spin = CV_SPIN_MAX);
+    ~bounded_queue() { delete[] buffer; }
+    bounded_queue(const bounded_queue&) = delete;
+    bounded_queue& operator=(const bounded_queue&) = delete;
+    std::size_t capacity() const { return mask + 1; }
+    void enqueue(const T& value) { T v(value); enqueue(std::move(v)); }
+    void enqueue(T&& value);
+    template<typename... Args> void emplace(Args&&... args) { enqueue(T(std::forward<Args>(args)...)); }
+    T dequeue();
+    bool try_dequeue(T& out);
+    std::optional<T> try_dequeue();
+    void enqueue_bulk(const T* values, std::size_t n);          /* blocks until all n are in */
+    std::size_t dequeue_bulk(T* out, std::size_t n);            /* up to n, never blocks */
+    std::size_t dequeue_bulk_wait(T* out, std::size_t n);       /* blocks for at least one */
+};
+
+/* Ring and bounded_queue capacities are powers of two so positions wrap
+   with a mask */
+inline std::size_t pow2_capacity(std::size_t capacity, std::size_t min) {
+    if(capacity < min || (capacity & (capacity - 1)) != 0)
+        throw std::invalid_argument("capacity must be a power of two");
+    return capacity;
+}
+
+/* Vyukov bounded MPMC ring. Every cell carries a sequence number that
+   says whose turn it is: pos for the producer of lap pos / capacity,
+   pos + 1 for its consumer, so producers and consumers only meet on the
+   two position counters and never take a lock. Capacity is a power of
+   two chosen at run time. */
+template<typename T, typename Layout = padded_layout>
+class mpmc_ring {
+    struct LAYOUT_ALIGN(Layout, std::atomic<std::size_t>) cell {
+        std::atomic<std::size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+        T* val() { return reinterpret_cast<T*>(storage); }
+    };
+    cell* const cells;
+    const std::size_t mask;
+    LAYOUT_ALIGN(Layout, std::atomic<std::size_t>) std::atomic<std::size_t> enqueue_pos;
+    LAYOUT_ALIGN(Layout, std::atomic<std::size_t>) std::atomic<std::size_t> dequeue_pos;
+
+    cell* claim_enqueue(std::size_t& pos);
+    CHECK_VALUE(T);
+public:
+    typedef T value_type;
+    explicit mpmc_ring(std::size_t capacity);
+    ~mpmc_ring();
+    mpmc_ring(const mpmc_ring&) = delete;
+    mpmc_ring& operator=(const mpmc_ring&) = delete;
+    std::size_t capacity() const { return mask + 1; }
+
+    bool try_enqueue(const T& value) { return try_emplace(value); }
+    bool try_enqueue(T&& value) { return try_emplace(std::move(value)); }
+    template<typename... Args> bool try_emplace(Args&&... args);
+    bool try_dequeue(T& out);
+    std::optional<T> try_dequeue();
+
+    /* Blocking wrappers: spin RING_SPIN failed attempts, then yield */
+    void enqueue(const T& value) { T v(value); enqueue(std::move(v)); }
+    void enqueue(T&& value);
+    T dequeue();
+};
+
+/* Single-producer single-consumer ring. Each side owns its index and
+   keeps a cached copy of the other side's, refreshed only when the ring
+   looks full (producer) or empty (consumer), so in steady state neither
+   side reads the other's cache line. No CAS anywhere. */
+template<typename T, typename Layout = padded_layout>
+class spsc_ring {
+    struct cell {
+        alignas(T) unsigned char storage[sizeof(T)];
+        T* val() { return reinterpret_cast<T*>(storage); }
+    };
+    cell* const cells;
+    const std::size_t mask;
+    /* producer side */
+    LAYOUT_ALIGN(Layout, std::atomic<std::size_t>) std::atomic<std::size_t> tail;
+    std::size_t cached_head;
+    /* consumer side */
+    LAYOUT_ALIGN(Layout, std::atomic<std::size_t>) std::atomic<std::size_t> head;
+    std::size_t cached_tail;
+public:
+    typedef T value_type;
+    explicit spsc_ring(std::size_t capacity);
+    ~spsc_ring();
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+    std::size_t capacity() const { return mask + 1; }
+
+    /* Producer thread only */
+    bool try_enqueue(const T& value) { return try_emplace(value); }
+    bool try_enqueue(T&& value) { return try_emplace(std::move(value)); }
+    template<typename... Args> bool try_emplace(Args&&... args);
+    void enqueue(const T& value) { T v(value); enqueue(std::move(v)); }
+    void enqueue(T&& value);
+
+    /* Consumer thread only */
+    bool try_dequeue(T& out);
+    std::optional<T> try_dequeue();
+    T dequeue();
+};
+
+/* Hook a type embeds (by deriving from it) to be linked into an
+   intrusive_mpsc */
+struct mpsc_hook {
+    std::atomic<mpsc_hook*> next;
+};
+
+/* Vyukov intrusive MPSC queue. push is one exchange and one store, so it
+   is wait-free for any number of producers. pop belongs to a single
+   consumer and returns null while the queue is empty, or while the last
+   producer is between its exchange and its store. A popped node is never
+   touched by the queue again and can be freed or reused at once. */
+template<typename Node, typename Layout = padded_layout>
+class intrusive_mpsc {
+    LAYOUT_ALIGN(Layout, std::atomic<mpsc_hook*>) std::atomic<mpsc_hook*> head;  /* producers */
+    LAYOUT_ALIGN(Layout, mpsc_hook*) mpsc_hook* tail;                           /* consumer */
+    mpsc_hook stub;
+    void link(mpsc_hook* n);
+    static_assert(std::is_base_of<mpsc_hook, Node>::value, "Node must derive from mpsc_hook");
+public:
+    intrusive_mpsc();
+    intrusive_mpsc(const intrusive_mpsc&) = delete;
+    intrusive_mpsc& operator=(const intrusive_mpsc&) = delete;
+    void push(Node* n) { link(n); }
+    Node* pop();
+};
+
+/* MPSC queue of values, one allocated node per value on an intrusive_mpsc.
+   Any number of threads may enqueue, only one may dequeue. */
+template<typename T, typename Alloc = new_alloc, typename Layout = padded_layout>
+class mpsc_queue {
+    struct node : mpsc_hook {
+        T value;
+        template<typename... Args>
+        explicit node(Args&&... args) : value(std::forward<Args>(args)...) {}
+    };
+    intrusive_mpsc<node, Layout> q;
+public:
+    typedef T value_type;
+    mpsc_queue() {}
+    ~mpsc_queue();
+    void enqueue(const T& value) { emplace(value); }
+    void enqueue(T&& value) { emplace(std::move(value)); }
+    template<typename... Args> void emplace(Args&&... args) {
+        q.push(Alloc::template create<node>(std::forward<Args>(args)...));
+    }
+    T dequeue();
+    bool try_dequeue(T& out);
+    std::optional<T> try_dequeue();
+};
+
+/* Chase-Lev work-stealing deque (Chase & Lev 2005, with the C11 orderings
+   of Le et al. 2013). The owner pushes and pops at the bottom with plain
+   stores and a fence, only racing thieves with a CAS on top for the last
+   item; thieves take from the top with one CAS. The circular array
+   doubles when full. Thieves may still read a replaced array, so old
+   arrays are kept until the deque is destroyed (at most the size of the
+   current one in total). Cells are read before the CAS that claims
+   them, so T must be trivially copyable, typically a task pointer. */
+template<typename T, typename Layout = padded_layout>
+class ws_deque {
+    struct array {
+        const std::size_t mask;
+        std::atomic<T>* const cells;
+        array* const prev;
+        array(std::size_t capacity, array* p)
+            : mask(capacity - 1), cells(new std::atomic<T>[capacity]), prev(p) {}
+        ~array() { delete[] cells; }
+        std::size_t capacity() const { return mask + 1; }
+        T get(std::int64_t i) const { return cells[i & mask].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, const T& v) { cells[i & mask].store(v, std::memory_order_relaxed); }
+    };
+    LAYOUT_ALIGN(Layout, std::atomic<std::int64_t>) std::atomic<std::int64_t> top;
+    LAYOUT_ALIGN(Layout, std::atomic<std::int64_t>) std::atomic<std::int64_t> bottom;
+    LAYOUT_ALIGN(Layout, std::atomic<array*>) std::atomic<array*> buf;
+
+    array* grow(array* a, std::int64_t t, std::int64_t b);
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ws_deque reads cells before claiming them, T must be trivially copyable");
+public:
+    typedef T value_type;
+    explicit ws_deque(std::size_t capacity = WS_CAPACITY);
+    ~ws_deque();
+    ws_deque(const ws_deque&) = delete;
+    ws_deque& operator=(const ws_deque&) = delete;
+    std::size_t capacity() const { return buf.load()->capacity(); }
+
+    /* Owner only */
+    void push_bottom(const T& value);
+    bool pop_bottom(T& out);
+    std::optional<T> pop_bottom();
+
+    /* Any thread: false if empty or another thread took the top first */
+    bool steal(T& out);
+    std::optional<T> steal();
+};
+
+/* Shards of a relaxed container. Every thread inserts into its own home
+   shard; a removal tries home first, then the fuller of two random
+   shards (two-choice stealing), then every shard once before reporting
+   empty. The per-shard sizes are estimates, only used to pick a victim.
+   Order only holds within a shard. */
+template<typename C, typename Layout>
+class shard_set {
+protected:
+    struct shard {
+        C c;
+        LAYOUT_ALIGN(Layout, std::atomic<long>) std::atomic<long> size;
+        shard() : size(0) {}
+    };
+    shard* shards;
+    std::size_t count;
+
+    explicit shard_set(std::size_t n);
+    ~shard_set() { delete[] shards; }
+    shard_set(const shard_set&) = delete;
+    shard_set& operator=(const shard_set&) = delete;
+
+    shard& home();
+    template<typename Take> std::size_t take(std::size_t n, Take&& from);
+public:
+    std::size_t shard_count() const { return count; }
+};
+
+/* Relaxed LIFO over SHARDS stacks (treiber_stack, sgl_stack, ...) */
+template<typename Stack, typename Layout = padded_layout>
+class sharded_stack : public shard_set<Stack, Layout> {
+    typedef shard_set<Stack, Layout> base;
+public:
+    typedef typename Stack::value_type value_type;
+    typedef value_type T;
+    explicit sharded_stack(std::size_t shards = SHARDS) : base(shards) {}
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+    template<typename... Args> void emplace(Args&&... args);
+    T pop();
+    bool try_pop(T& out);
+    std::optional<T> try_pop();
+    void push_n(const T* values, std::size_t n);
+    std::size_t pop_n(T* out, std::size_t n);
+};
+
+/* Relaxed FIFO over SHARDS queues (msqueue, sgl_queue, ...) */
+template<typename Queue, typename Layout = padded_layout>
+class sharded_queue : public shard_set<Queue, Layout> {
+    typedef shard_set<Queue, Layout> base;
+public:
+    typedef typename Queue::value_type value_type;
+    typedef value_type T;
+    explicit sharded_queue(std::size_t shards = SHARDS) : base(shards) {}
+    void enqueue(const T& value) { emplace(value); }
+    void enqueue(T&& value) { emplace(std::move(value)); }
+    template<typename... Args> void emplace(Args&&... args);
+    T dequeue();
+    bool try_dequeue(T& out);
+    std::optional<T> try_dequeue();
+    void enqueue_bulk(const T* values, std::size_t n);
+    std::size_t dequeue_bulk(T* out, std::size_t n);
+};
+
+/* Single global lock hash map */
+template<typename K, typename V, typename Hash = std::hash<K>>
+class sgl_map {
+    std::unordered_map<K, V, Hash> data;
     std::mutex lock;
-    condvar_no_spurious not_full, not_empty;
 public:
-    bounded_queue() : head(0), tail(0), count(0) {}
-    void enqueue(int value);
-    int dequeue();
+    typedef K key_type;
+    typedef V mapped_type;
+    explicit sgl_map(std::size_t buckets = MAP_BUCKETS) : data(buckets) {}
+    bool insert(const K& key, const V& value);
+    bool find(const K& key, V& out);
+    std::optional<V> find(const K& key);
+    bool contains(const K& key);
+    bool erase(const K& key);
+    std::size_t size();
+};
+
+/* Lock-free hash map over a split-ordered list (Shalev & Shavit 2006).
+   All items sit in one Harris-Michael list sorted by their bit-reversed
+   hash, and bucket b is a dummy node at the position of reverse(b), so
+   doubling the bucket count only raises the count: a new bucket's dummy
+   is linked in lazily, after its parent's, by the first operation that
+   hashes to it, and no item ever moves. The bucket directory is a set of
+   segments of doubling size that are never reallocated. Items are
+   retired through Reclaim once unlinked; lookups copy the value out. */
+template<typename K, typename V,
+         typename Hash = std::hash<K>,
+         typename Reclaim = hazard_pointers,
+         typename Alloc = new_alloc,
+         typename Layout = padded_layout>
+class split_ordered_map {
+    struct node {
+        std::uint64_t so;               /* split-order key, odd for items */
+        marked_ptr<node> next;
+        std::optional<std::pair<K, V>> item;    /* empty in a bucket dummy */
+        explicit node(std::uint64_t s) : so(s), next(nullptr) {}
+        node(std::uint64_t s, const K& k, const V& v) : so(s), next(nullptr), item(std::in_place, k, v) {}
+    };
+    typedef tagged<node> link;
+    static const int SEGMENTS = 64;     /* segment s > 0 holds buckets [2^(s-1), 2^s) */
+
+    std::atomic<std::atomic<node*>*> segments[SEGMENTS];
+    LAYOUT_ALIGN(Layout, std::atomic<std::size_t>) std::atomic<std::size_t> buckets;
+    LAYOUT_ALIGN(Layout, std::atomic<std::ptrdiff_t>) std::atomic<std::ptrdiff_t> count{0};   /* an erase may count first */
+
+    static void free_node(void* p) { Alloc::destroy(static_cast<node*>(p)); }
+    static std::uint64_t hash_of(const K& key);
+    std::atomic<node*>& slot(std::size_t b);
+    node* bucket(std::size_t b, typename Reclaim::guard& g);
+    bool find(node* start, std::uint64_t so, const K* key, marked_ptr<node>*& prev, node*& cur,
+              typename Reclaim::guard& g);
+    static_assert(!Reclaim::immediate, "split_ordered_map needs deferred reclamation");
+public:
+    typedef K key_type;
+    typedef V mapped_type;
+    explicit split_ordered_map(std::size_t initial_buckets = MAP_BUCKETS);
+    ~split_ordered_map();
+    split_ordered_map(const split_ordered_map&) = delete;
+    split_ordered_map& operator=(const split_ordered_map&) = delete;
+    bool insert(const K& key, const V& value);
+    bool find(const K& key, V& out);
+    std::optional<V> find(const K& key);
+    bool contains(const K& key);
+    bool erase(const K& key);
+    std::size_t size() const { return (std::size_t)std::max<std::ptrdiff_t>(count.load(std::memory_order_relaxed), 0); }
+    std::size_t bucket_count() const { return buckets.load(std::memory_order_relaxed); }
 };
 
-#endif
\ No newline at end of file
+#include "sgl_stack.h"
+#include "sgl_queue.h"
+#include "treiber_stack.h"
+#include "msqueue.h"
+#include "faa_queue.h"
+#include "elimination_stack.h"
+#include "adaptive_stack.h"
+#include "fc_stack.h"
+#include "cc_synch.h"
+#include "fc_queue.h"
+#include "skiplist_pq.h"
+#include "bounded_queue.h"
+#include "mpmc_ring.h"
+#include "spsc_ring.h"
+#include "mpsc_queue.h"
+#include "ws_deque.h"
+#include "sharded.h"
+#include "sgl_map.h"
+#include "split_ordered_map.h"
+
+#ifdef CONTAINERS_HEADER_ONLY
+#include "condvar.cpp"
+#endif
+
+#endif
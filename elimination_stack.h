@@ -0,0 +1,250 @@
+/*
+ * elimination_stack.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Elimination Stack - optimized Treiber stack with elimination array.
+ */
+
+#ifndef ELIMINATION_STACK_H
+#define ELIMINATION_STACK_H
+
+#include "containers.h"
+#include "rng.h"
+
+/* Slot word layout: tag in the high 16 bits, node pointer in the middle,
+   exchange state in the low 2 bits (nodes are at least 8-byte aligned) */
+enum { SLOT_EMPTY = 0, SLOT_PUSH = 1, SLOT_POP = 2, SLOT_DELIVERED = 3 };
+static const std::uint64_t SLOT_STATE_MASK = 3;
+static const std::uint64_t SLOT_PTR_MASK = (((std::uint64_t)1 << 48) - 1) & ~(std::uint64_t)7;
+
+inline int slot_state(std::uint64_t w) { return (int)(w & SLOT_STATE_MASK); }
+inline void* slot_ptr(std::uint64_t w) { return reinterpret_cast<void*>(w & SLOT_PTR_MASK); }
+inline std::uint64_t slot_word(std::uint64_t prev, int state, void* p = nullptr) {
+    std::uint64_t tag = (prev >> 48) + 1;
+    return (tag << 48) | (reinterpret_cast<std::uint64_t>(p) & SLOT_PTR_MASK) | (std::uint64_t)state;
+}
+
+/* Active part of the array: shrinks after a timeout (too few partners),
+   grows when the chosen slot was busy (too many). Kept per thread and per
+   array, so contention on one container leaves the others alone; an array
+   evicted from the cache starts over at half width */
+template<typename Layout>
+int& elimination_array<Layout>::range() {
+    auto& e = instance_cache<elimination_array, int>::of(id);
+    if(e.id != id) e = {id, ELIM_SIZE / 2};
+    return e.value;
+}
+
+inline void elim_shrink(int& range) { if(range > 1) range /= 2; }
+inline void elim_grow(int& range) { if(range < ELIM_SIZE) range *= 2; }
+
+/* Destructor: drain and free all nodes */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+elimination_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::~elimination_stack() {
+    while(top.load().ptr) {
+        node* n = top.load().ptr;
+        top.store(n->next.load(std::memory_order_relaxed));
+        Alloc::destroy(n);
+    }
+}
+
+/* Offer n to a pop: hand it to a waiting pop, or publish it and wait a
+   bounded spin window for one to take it. Returns true if a pop got n.
+   Every exchange has exactly one pop, so only that side counts it. */
+template<typename Layout>
+bool elimination_array<Layout>::exchange_push(void* n) {
+    int& r = range();
+    std::atomic<std::uint64_t>& slot = slots[thread_rng().below(r)].word;
+    std::uint64_t cur = slot.load();
+
+    if(slot_state(cur) == SLOT_POP) {
+        /* A pop is waiting: deliver n directly */
+        if(slot.compare_exchange_strong(cur, slot_word(cur, SLOT_DELIVERED, n))) return true;
+        elim_grow(r);
+        return false;
+    }
+    if(slot_state(cur) != SLOT_EMPTY) {
+        elim_grow(r);
+        return false;
+    }
+
+    std::uint64_t mine = slot_word(cur, SLOT_PUSH, n);
+    if(!slot.compare_exchange_strong(cur, mine)) {
+        elim_grow(r);
+        return false;
+    }
+    for(int spin = 0; spin < ELIM_SPIN; spin++)
+        if(slot.load() != mine) return true;
+
+    /* Timed out: withdraw, unless a pop took n at the last moment */
+    if(slot.compare_exchange_strong(mine, slot_word(mine, SLOT_EMPTY))) {
+        elim_shrink(r);
+        return false;
+    }
+    return true;
+}
+
+/* Take a node from a waiting push, or publish a pop request and wait a
+   bounded spin window for a push to deliver one. Returns null on failure. */
+template<typename Layout>
+void* elimination_array<Layout>::exchange_pop() {
+    stat_add(STAT_ELIM_ATTEMPTS);
+    int& r = range();
+    std::atomic<std::uint64_t>& slot = slots[thread_rng().below(r)].word;
+    std::uint64_t cur = slot.load();
+
+    if(slot_state(cur) == SLOT_PUSH) {
+        /* A push is waiting: take its node */
+        if(slot.compare_exchange_strong(cur, slot_word(cur, SLOT_EMPTY))) {
+            stat_add(STAT_ELIM_HITS);
+            return slot_ptr(cur);
+        }
+        elim_grow(r);
+        return nullptr;
+    }
+    if(slot_state(cur) != SLOT_EMPTY) {
+        elim_grow(r);
+        return nullptr;
+    }
+
+    std::uint64_t mine = slot_word(cur, SLOT_POP);
+    if(!slot.compare_exchange_strong(cur, mine)) {
+        elim_grow(r);
+        return nullptr;
+    }
+    std::uint64_t seen = mine;
+    for(int spin = 0; spin < ELIM_SPIN && seen == mine; spin++)
+        seen = slot.load();
+
+    /* Timed out: withdraw, unless a push delivered at the last moment */
+    if(seen == mine) {
+        if(slot.compare_exchange_strong(seen, slot_word(mine, SLOT_EMPTY))) {
+            elim_shrink(r);
+            return nullptr;
+        }
+    }
+
+    /* Only the delivering push can change our request: free the slot */
+    slot.store(slot_word(seen, SLOT_EMPTY));
+    stat_add(STAT_ELIM_HITS);
+    return slot_ptr(seen);
+}
+
+/* Push: try the stack first, after a failed CAS offer the node to a pop.
+   The value is built in its node, so an exchange hands over a pointer. */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+template<typename... Args>
+void elimination_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::emplace(Args&&... args) {
+    node* n = Alloc::template create<node>(std::forward<Args>(args)...);
+    typename Backoff::state b;
+    while(true) {
+        tagged<node> old_top = top.load();
+        n->next.store(old_top.ptr, std::memory_order_relaxed);
+        if(stat_cas(top.compare_exchange(old_top, n))) {
+            nonempty.notify();
+            return;
+        }
+        
+        /* Contention on top: try to eliminate against a concurrent pop */
+        if(elim.exchange_push(n)) return;
+        b.pause();
+    }
+}
+
+/* Pop: try the stack first, after a failed CAS look for a concurrent push */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+T elimination_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop() {
+    T v;
+    if(!try_pop(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+/* Non-throwing pop: returns false if empty */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+bool elimination_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::try_pop(T& out) {
+    return pop_n(&out, 1) == 1;
+}
+
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+std::optional<T> elimination_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::try_pop() {
+    T v;
+    if(!try_pop(v)) return std::nullopt;
+    return v;
+}
+
+/* Blocking pop: spin, then sleep until a push */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+T elimination_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop_wait() {
+    T v;
+    await_item(nonempty, [&] { return try_pop(v); });
+    return v;
+}
+
+/* Timed pop: nullopt if nothing arrived before the timeout */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+template<typename Rep, typename Period>
+std::optional<T> elimination_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop_for(const std::chrono::duration<Rep, Period>& timeout) {
+    T v;
+    if(!await_item(nonempty, [&] { return try_pop(v); }, wait_deadline(timeout))) return std::nullopt;
+    return v;
+}
+
+/* Bulk push: splice a pre-linked chain with one CAS. A chain cannot be
+   handed to a single pop, so it never goes through the exchanger. */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+void elimination_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::push_n(const T* values, std::size_t n) {
+    if(n == 0) return;
+    if(n == 1) {
+        push(values[0]);
+        return;
+    }
+    node* last = Alloc::template create<node>(values[0]);
+    node* first = last;
+    for(std::size_t i = 1; i < n; i++) {
+        node* n2 = Alloc::template create<node>(values[i]);
+        n2->next.store(first, std::memory_order_relaxed);
+        first = n2;
+    }
+    typename Backoff::state b;
+    while(true) {
+        tagged<node> old_top = top.load();
+        last->next.store(old_top.ptr, std::memory_order_relaxed);
+        if(stat_cas(top.compare_exchange(old_top, first))) {
+            nonempty.notify(n);
+            return;
+        }
+        b.pause();
+    }
+}
+
+/* Pop up to n values, each one from the stack or from the exchanger */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+std::size_t elimination_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop_n(T* out, std::size_t n) {
+    typename Reclaim::guard g;
+    typename Backoff::state b;
+    std::size_t got = 0;
+    while(got < n) {
+        tagged<node> old_top = g.protect(0, top);
+        if(!old_top.ptr) break;
+        
+        node* next = old_top.ptr->next.load(std::memory_order_relaxed);
+        if(stat_cas(top.compare_exchange(old_top, next))) {
+            out[got++] = std::move(old_top.ptr->value);
+            g.clear(0);
+            Reclaim::retire(old_top.ptr, free_node);
+            continue;
+        }
+        
+        /* An eliminated node never reached the stack, so no other thread
+           can hold a reference to it: free it directly */
+        if(node* e = static_cast<node*>(elim.exchange_pop())) {
+            out[got++] = std::move(e->value);
+            Alloc::destroy(e);
+        } else {
+            b.pause();
+        }
+    }
+    return got;
+}
+
+#endif
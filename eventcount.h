@@ -0,0 +1,91 @@
+/*
+ * eventcount.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Eventcount for blocking pops on the lock-free containers.
+ *
+ * A consumer that found its container empty registers, rechecks, and only
+ * then sleeps, so a producer pays one load while nobody is registered:
+ *   key = ec.prepare_wait()          register and snapshot the epoch
+ *   ... recheck the container ...
+ *   ec.cancel_wait()                 found an item after all
+ *   ec.commit_wait(key, deadline)    sleep until notified or the deadline
+ *   ec.notify(n)                     after publishing n items
+ */
+
+#ifndef EVENTCOUNT_H
+#define EVENTCOUNT_H
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include "backoff.h"
+
+#if defined(__linux__)
+#define HAVE_FUTEX 1
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+/* Attempts a blocking pop spins before it registers and sleeps */
+#define WAIT_SPIN 128
+
+class eventcount {
+    std::atomic<std::uint32_t> epoch{0};
+    std::atomic<int> waiters{0};
+#ifndef HAVE_FUTEX
+    std::mutex lock;                    /* sleepers only, never on notify's fast path */
+    std::condition_variable cv;
+#endif
+    void wake(int n);
+public:
+    typedef std::chrono::steady_clock clock;
+
+    std::uint32_t prepare_wait() {
+        waiters.fetch_add(1);
+        return epoch.load();
+    }
+    void cancel_wait() { waiters.fetch_sub(1); }
+
+    /* Returns false if the deadline passed before a notify */
+    bool commit_wait(std::uint32_t key, clock::time_point deadline = clock::time_point::max());
+
+    /* The caller has published with a seq_cst read-modify-write (the
+       container's CAS). That and this seq_cst load are ordered against
+       prepare_wait() without a fence: either the waiter's recheck sees
+       the item or this load sees the waiter. */
+    void notify(std::size_t n = 1) {
+        if(waiters.load()) wake(n < INT_MAX ? (int)n : INT_MAX);
+    }
+};
+
+/* Spin-then-park: retry attempt() WAIT_SPIN times, then register and
+   retry once more before every sleep. Returns false once the deadline
+   has passed without attempt() succeeding. */
+template<typename Attempt>
+bool await_item(eventcount& ec, Attempt&& attempt,
+                eventcount::clock::time_point deadline = eventcount::clock::time_point::max()) {
+    for(int i = 0; i < WAIT_SPIN; i++) {
+        if(attempt()) return true;
+        cpu_relax();
+    }
+    while(true) {
+        std::uint32_t key = ec.prepare_wait();
+        if(attempt()) {
+            ec.cancel_wait();
+            return true;
+        }
+        if(!ec.commit_wait(key, deadline)) return attempt();
+    }
+}
+
+/* Deadline of a timed pop */
+template<typename Rep, typename Period>
+eventcount::clock::time_point wait_deadline(const std::chrono::duration<Rep, Period>& timeout) {
+    return eventcount::clock::now() + std::chrono::duration_cast<eventcount::clock::duration>(timeout);
+}
+
+#endif
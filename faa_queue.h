@@ -0,0 +1,201 @@
+/*
+ * faa_queue.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: FAA-array queue - lock-free FIFO of fetch_add indexed segments.
+ */
+
+#ifndef FAA_QUEUE_H
+#define FAA_QUEUE_H
+
+#include "containers.h"
+#include <algorithm>
+
+/* Every cell starts empty; the indices only ever grow */
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+faa_queue<T, Reclaim, Alloc, Layout>::segment::segment() : enq_idx(0), deq_idx(0), next(nullptr) {
+    for(cell& c : cells) c.state.store(CELL_EMPTY, std::memory_order_relaxed);
+}
+
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+faa_queue<T, Reclaim, Alloc, Layout>::faa_queue() {
+    segment* s = Alloc::template create<segment>();
+    head.store(s);
+    tail.store(s);
+}
+
+/* Destructor: destroy the values still in full cells and free every segment */
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+faa_queue<T, Reclaim, Alloc, Layout>::~faa_queue() {
+    segment* s = head.load();
+    while(s) {
+        segment* next = s->next.load();
+        std::size_t end = std::min<std::size_t>(s->enq_idx.load(), FAA_SEGMENT);
+        for(std::size_t i = 0; i < end; i++)
+            if(s->cells[i].state.load() == CELL_FULL) s->cells[i].val()->~T();
+        Alloc::destroy(s);
+        s = next;
+    }
+}
+
+/* Claim a cell in the tail segment and publish v into it; a full segment
+   gets a successor that already holds v in its first cell. v is moved
+   back out whenever an attempt loses its cell. */
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+void faa_queue<T, Reclaim, Alloc, Layout>::put(T& v) {
+    typename Reclaim::guard g;
+    while(true) {
+        segment* t = g.protect(0, tail);
+        std::size_t i = t->enq_idx.fetch_add(1);
+        if(i >= FAA_SEGMENT) {
+            if(t != tail.load()) continue;
+            segment* next = t->next.load();
+            if(next) {
+                /* Tail is lagging, help advance it */
+                tail.compare_exchange_strong(t, next);
+                continue;
+            }
+            segment* s = Alloc::template create<segment>();
+            new (s->cells[0].storage) T(std::move(v));
+            s->cells[0].state.store(CELL_FULL, std::memory_order_relaxed);
+            s->enq_idx.store(1, std::memory_order_relaxed);
+            if(t->next.compare_exchange_strong(next, s)) {
+                tail.compare_exchange_strong(t, s);
+                return;
+            }
+            v = std::move(*s->cells[0].val());
+            s->cells[0].val()->~T();
+            Alloc::destroy(s);
+            continue;
+        }
+
+        cell& c = t->cells[i];
+        new (c.storage) T(std::move(v));
+        int expected = CELL_EMPTY;
+        if(c.state.compare_exchange_strong(expected, CELL_FULL)) return;
+
+        /* A dequeuer gave up on this cell first */
+        v = std::move(*c.val());
+        c.val()->~T();
+    }
+}
+
+/* The value is built once, then moved into whichever cell it wins */
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+template<typename... Args>
+void faa_queue<T, Reclaim, Alloc, Layout>::emplace(Args&&... args) {
+    T v(std::forward<Args>(args)...);
+    put(v);
+    nonempty.notify();
+}
+
+/* Dequeue: throws if the queue is empty */
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+T faa_queue<T, Reclaim, Alloc, Layout>::dequeue() {
+    T v;
+    if(!try_dequeue(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+/* Non-throwing dequeue: returns false if empty */
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+bool faa_queue<T, Reclaim, Alloc, Layout>::try_dequeue(T& out) {
+    return dequeue_bulk(&out, 1) == 1;
+}
+
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+std::optional<T> faa_queue<T, Reclaim, Alloc, Layout>::try_dequeue() {
+    T v;
+    if(!try_dequeue(v)) return std::nullopt;
+    return v;
+}
+
+/* Blocking dequeue: spin, then sleep until an enqueue */
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+T faa_queue<T, Reclaim, Alloc, Layout>::dequeue_wait() {
+    T v;
+    await_item(nonempty, [&] { return try_dequeue(v); });
+    return v;
+}
+
+/* Timed dequeue: nullopt if nothing arrived before the timeout */
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+template<typename Rep, typename Period>
+std::optional<T> faa_queue<T, Reclaim, Alloc, Layout>::dequeue_for(const std::chrono::duration<Rep, Period>& timeout) {
+    T v;
+    if(!await_item(nonempty, [&] { return try_dequeue(v); }, wait_deadline(timeout))) return std::nullopt;
+    return v;
+}
+
+/* Claim a run of cells with one FAA and fill them in order. The first
+   cell lost to a dequeuer abandons the rest of the run, so the batch
+   stays in order; abandoned cells are skipped like any lost cell. */
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+void faa_queue<T, Reclaim, Alloc, Layout>::enqueue_bulk(const T* values, std::size_t n) {
+    typename Reclaim::guard g;
+    std::size_t done = 0;
+    while(done < n) {
+        segment* t = g.protect(0, tail);
+        std::size_t want = n - done;
+        std::size_t i = t->enq_idx.fetch_add(want);
+        if(i >= FAA_SEGMENT) {
+            /* Segment is full: the single-item path links a successor,
+               through put() so the one notify below covers it too */
+            g.clear(0);
+            T v(values[done++]);
+            put(v);
+            continue;
+        }
+        for(std::size_t k = 0; k < want && i + k < FAA_SEGMENT; k++) {
+            cell& c = t->cells[i + k];
+            new (c.storage) T(values[done]);
+            int expected = CELL_EMPTY;
+            if(!c.state.compare_exchange_strong(expected, CELL_FULL)) {
+                c.val()->~T();
+                break;
+            }
+            done++;
+        }
+    }
+    nonempty.notify(n);
+}
+
+/* Dequeue up to n values, claiming at most as many cells as look full
+   with one FAA, returns how many were dequeued.
+   Note: the head segment stays protected while values are moved out */
+template<typename T, typename Reclaim, typename Alloc, typename Layout>
+std::size_t faa_queue<T, Reclaim, Alloc, Layout>::dequeue_bulk(T* out, std::size_t n) {
+    typename Reclaim::guard g;
+    std::size_t got = 0;
+    while(got < n) {
+        segment* h = g.protect(0, head);
+        std::size_t deq = h->deq_idx.load(), enq = h->enq_idx.load();
+        if(deq >= enq && !h->next.load()) break;
+
+        std::size_t want = enq > deq ? std::min(n - got, enq - deq) : 1;
+        std::size_t i = h->deq_idx.fetch_add(want);
+        if(i >= FAA_SEGMENT) {
+            /* Segment is drained: move head on, tail first if it lags,
+               so a retired segment is never reachable from either */
+            segment* next = h->next.load();
+            if(!next) break;
+            segment* t = h;
+            tail.compare_exchange_strong(t, next);
+            if(head.compare_exchange_strong(h, next)) {
+                g.clear(0);
+                Reclaim::retire(h, free_segment);
+            }
+            continue;
+        }
+        for(std::size_t k = 0; k < want && i + k < FAA_SEGMENT; k++) {
+            cell& c = h->cells[i + k];
+            if(c.state.exchange(CELL_TAKEN) == CELL_FULL) {
+                out[got++] = std::move(*c.val());
+                c.val()->~T();
+            }
+        }
+    }
+    return got;
+}
+
+#endif
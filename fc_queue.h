@@ -0,0 +1,68 @@
+/*
+ * fc_queue.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Combining Queue - delegation-based concurrent queue over cc_synch.
+ */
+
+#ifndef FC_QUEUE_H
+#define FC_QUEUE_H
+
+#include "containers.h"
+
+/* Enqueue: the combiner moves the value out of the caller's object,
+   which outlives the request */
+template<typename T, typename Layout, typename Backoff, typename Topology, typename Store>
+void fc_queue<T, Layout, Backoff, Topology, Store>::enqueue(T&& value) {
+    sync.execute([&](Store& s) { s.push(std::move(value)); });
+}
+
+/* Dequeue: throws if the queue is empty */
+template<typename T, typename Layout, typename Backoff, typename Topology, typename Store>
+T fc_queue<T, Layout, Backoff, Topology, Store>::dequeue() {
+    T v;
+    if(!try_dequeue(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+/* Try-dequeue: the combiner says explicitly whether it found an item, so
+   a stored -1 is a value; the item is written straight into out */
+template<typename T, typename Layout, typename Backoff, typename Topology, typename Store>
+bool fc_queue<T, Layout, Backoff, Topology, Store>::try_dequeue(T& out) {
+    bool ok = false;
+    sync.execute([&](Store& s) {
+        ok = !s.empty();
+        if(ok) out = s.take();
+    });
+    return ok;
+}
+
+template<typename T, typename Layout, typename Backoff, typename Topology, typename Store>
+std::optional<T> fc_queue<T, Layout, Backoff, Topology, Store>::try_dequeue() {
+    T v;
+    if(!try_dequeue(v)) return std::nullopt;
+    return v;
+}
+
+/* Bulk enqueue: the whole span is one request (copies, so it is only
+   available for copyable T) */
+template<typename T, typename Layout, typename Backoff, typename Topology, typename Store>
+void fc_queue<T, Layout, Backoff, Topology, Store>::enqueue_bulk(const T* values, std::size_t n) {
+    if(n == 0) return;
+    sync.execute([&](Store& s) {
+        for(std::size_t i = 0; i < n; i++) s.push(values[i]);
+    });
+}
+
+/* Bulk dequeue: the combiner fills the span and reports how many it got */
+template<typename T, typename Layout, typename Backoff, typename Topology, typename Store>
+std::size_t fc_queue<T, Layout, Backoff, Topology, Store>::dequeue_bulk(T* out, std::size_t n) {
+    if(n == 0) return 0;
+    std::size_t got = 0;
+    sync.execute([&](Store& s) {
+        while(got < n && !s.empty()) out[got++] = s.take();
+    });
+    return got;
+}
+
+#endif
@@ -0,0 +1,255 @@
+/*
+ * fc_stack.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Flat Combining Stack - delegation-based concurrent stack.
+ */
+
+#ifndef FC_STACK_H
+#define FC_STACK_H
+
+#include "containers.h"
+#include <thread>
+#include <algorithm>
+
+/* One domain per node; a single node is plain flat combining */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+fc_stack<T, Layout, Backoff, Topology>::fc_stack(std::size_t nodes) : domains(nullptr), node_count(nodes), id(next_id.fetch_add(1) + 1) {
+    if(nodes == 0) throw std::invalid_argument("need at least one node");
+    domains = new domain[nodes];
+}
+
+/* Destructor: free every publication record */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+fc_stack<T, Layout, Backoff, Topology>::~fc_stack() {
+    for(record* r : records) delete r;
+    delete[] domains;
+}
+
+/* Find this thread's record: the thread-local instance cache covers the
+   common case, even for a thread that alternates between stacks; only a
+   miss takes the lock and scans the records */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+typename fc_stack<T, Layout, Backoff, Topology>::record* fc_stack<T, Layout, Backoff, Topology>::get_record() {
+    auto& cached = instance_cache<fc_stack, record*>::of(id);
+    if(cached.id == id) return cached.value;
+
+    std::thread::id me = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lk(records_lock);
+    record* r = nullptr;
+    for(record* x : records)
+        if(x->owner == me) r = x;
+    if(!r) {
+        r = new record();
+        r->op = 0;
+        r->active = false;
+        r->age = 0;
+        r->next = nullptr;
+        r->home = &domains[Topology::node() % node_count];
+        r->owner = me;
+        records.push_back(r);
+    }
+    cached = {id, r};
+    return r;
+}
+
+/* Push record onto the head of its node's publication list */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+void fc_stack<T, Layout, Backoff, Topology>::enlist(record* r) {
+    domain& d = *r->home;
+    r->active.store(true);
+    record* old_head = d.pub_head.load();
+    do {
+        r->next = old_head;
+    } while(!d.pub_head.compare_exchange_weak(old_head, r));
+}
+
+/* Unlink records that have been idle for FC_MAX_AGE rounds. Only the
+   combiner edits interior links; the head is left alone because other
+   threads CAS it concurrently. */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+void fc_stack<T, Layout, Backoff, Topology>::cleanup(domain& d) {
+    record* prev = d.pub_head.load();
+    if(!prev) return;
+    record* r = prev->next;
+    while(r) {
+        record* next = r->next;
+        if(r->op.load() == 0 && d.rounds - r->age > FC_MAX_AGE) {
+            prev->next = next;
+            r->active.store(false);
+        } else {
+            prev = r;
+        }
+        r = next;
+    }
+}
+
+/* Combiner: serve the node's publication list until a pass finds nothing
+   new or FC_PASSES have run. Within a pass pushes are paired with pops
+   first, the pop simply takes the push's value (push linearized right
+   before it), and only the leftover side touches the array - under the
+   stack-wide lock when other nodes combine too. */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+void fc_stack<T, Layout, Backoff, Topology>::combine(domain& d) {
+    d.rounds++;
+    stat_add(STAT_FC_COMBINES);
+    for(int pass = 0; pass < FC_PASSES; pass++) {
+        d.pushes.clear();
+        d.pops.clear();
+        d.bulks.clear();
+        for(record* r = d.pub_head.load(); r; r = r->next) {
+            int op = r->op.load(std::memory_order_acquire);
+            if(op == 1) d.pushes.push_back(r);
+            else if(op == 2) d.pops.push_back(r);
+            else if(op == 3 || op == 4) d.bulks.push_back(r);
+        }
+        std::size_t served = d.pushes.size() + d.pops.size() + d.bulks.size();
+        if(served == 0) break;
+        stat_add(STAT_FC_PASSES);
+        
+        /* Eliminate matching push/pop pairs inside the batch */
+        std::size_t paired = std::min(d.pushes.size(), d.pops.size());
+        for(std::size_t i = 0; i < paired; i++) {
+            d.pops[i]->result.put(std::move(d.pushes[i]->val.get()));
+            d.pops[i]->ok = true;
+        }
+        
+        std::unique_lock<std::mutex> shared(lock, std::defer_lock);
+        if(node_count > 1 && served > 2 * paired) {
+            shared.lock();
+            stat_add(STAT_FC_SHARED);
+        }
+        
+        /* Execute bulk requests, a whole span per record */
+        for(record* r : d.bulks) {
+            if(r->op.load(std::memory_order_relaxed) == 3) {
+                /* push_n copies and refuses to compile for other T, so op 3
+                   is never posted for them; the guard only keeps combine()
+                   instantiable */
+                if constexpr(std::is_copy_constructible<T>::value)
+                    data.insert(data.end(), r->span_in, r->span_in + r->span_n);
+            } else {
+                std::size_t got = 0;
+                while(got < r->span_n && !data.empty()) {
+                    r->span_out[got++] = std::move(data.back());
+                    data.pop_back();
+                }
+                r->span_n = got;
+            }
+        }
+        
+        /* Execute leftover push requests */
+        for(std::size_t i = paired; i < d.pushes.size(); i++)
+            data.push_back(std::move(d.pushes[i]->val.get()));
+        
+        /* Execute leftover pop requests */
+        for(std::size_t i = paired; i < d.pops.size(); i++) {
+            d.pops[i]->ok = !data.empty();
+            if(d.pops[i]->ok) {
+                d.pops[i]->result.put(std::move(data.back()));
+                data.pop_back();
+            }
+        }
+        if(shared.owns_lock()) shared.unlock();
+        
+        for(record* r : d.pushes) {
+            r->age = d.rounds;
+            r->op.store(0, std::memory_order_release);
+        }
+        for(record* r : d.pops) {
+            r->age = d.rounds;
+            r->op.store(0, std::memory_order_release);
+        }
+        for(record* r : d.bulks) {
+            r->age = d.rounds;
+            r->op.store(0, std::memory_order_release);
+        }
+        stat_add(STAT_FC_OPS, served);
+        stat_add(STAT_FC_PAIRED, 2 * paired);
+    }
+    if(d.rounds % FC_CLEANUP_PERIOD == 0) cleanup(d);
+}
+
+/* Wait for the node's combiner, re-enlisting if cleanup dropped the record and
+   taking over as combiner whenever the node lock is free. Backoff paces the
+   polling so waiters neither hammer the lock line nor make a syscall
+   per check. */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+void fc_stack<T, Layout, Backoff, Topology>::wait_for(record* r) {
+    domain& d = *r->home;
+    typename Backoff::state b;
+    while(r->op.load(std::memory_order_acquire) != 0) {
+        if(!r->active.load()) enlist(r);
+        if(d.lock.try_lock()) {
+            combine(d);
+            d.lock.unlock();
+        } else {
+            b.pause();
+        }
+    }
+}
+
+/* Push: post request to record and wait for combiner */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+void fc_stack<T, Layout, Backoff, Topology>::push(T&& value) {
+    record* r = get_record();
+    r->val.send(value);
+    r->op.store(1, std::memory_order_release);
+    wait_for(r);
+}
+
+/* Pop: throws if the stack is empty */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+T fc_stack<T, Layout, Backoff, Topology>::pop() {
+    T v;
+    if(!try_pop(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+/* Try-pop: post request to record and wait for combiner, the combiner
+   says explicitly whether it found an item, so a stored -1 is a value.
+   A by-address result is written straight into out. */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+bool fc_stack<T, Layout, Backoff, Topology>::try_pop(T& out) {
+    record* r = get_record();
+    r->result.expect(out);
+    r->op.store(2, std::memory_order_release);
+    wait_for(r);
+    
+    if(!r->ok) return false;
+    r->result.receive(out);
+    return true;
+}
+
+template<typename T, typename Layout, typename Backoff, typename Topology>
+std::optional<T> fc_stack<T, Layout, Backoff, Topology>::try_pop() {
+    T v;
+    if(!try_pop(v)) return std::nullopt;
+    return v;
+}
+
+/* Bulk push: the whole span travels in one publication record */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+void fc_stack<T, Layout, Backoff, Topology>::push_n(const T* values, std::size_t n) {
+    static_assert(std::is_copy_constructible<T>::value, "push_n copies");
+    if(n == 0) return;
+    record* r = get_record();
+    r->span_in = values;
+    r->span_n = n;
+    r->op.store(3, std::memory_order_release);
+    wait_for(r);
+}
+
+/* Bulk pop: the combiner fills the span and reports how many it got */
+template<typename T, typename Layout, typename Backoff, typename Topology>
+std::size_t fc_stack<T, Layout, Backoff, Topology>::pop_n(T* out, std::size_t n) {
+    if(n == 0) return 0;
+    record* r = get_record();
+    r->span_out = out;
+    r->span_n = n;
+    r->op.store(4, std::memory_order_release);
+    wait_for(r);
+    return r->span_n;
+}
+
+#endif
@@ -0,0 +1,185 @@
+/*
+ * harness.cpp
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Benchmark harness option parsing and table/CSV/JSON output.
+ */
+
+#include "harness.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+/* Whole decimal number >= min, the option name goes into any error */
+static long parse_count(const std::string& opt, const std::string& v, long min) {
+    char* end = nullptr;
+    long n = std::strtol(v.c_str(), &end, 10);
+    if(v.empty() || *end != '\0' || n < min)
+        throw std::invalid_argument(opt + ": expected a number >= " + std::to_string(min) + ", got '" + v + "'");
+    return n;
+}
+
+bench_options parse_bench_options(int argc, char** argv, int first, const bench_options& defaults) {
+    bench_options o = defaults;
+    for(int i = first; i < argc; i++) {
+        std::string opt = argv[i];
+        if(opt == "-perf") {
+            o.perf = true;
+            continue;
+        }
+        if(i + 1 >= argc) throw std::invalid_argument(opt + ": missing value");
+        std::string v = argv[++i];
+
+        if(opt == "-threads") {
+            o.threads.clear();
+            std::stringstream list(v);
+            std::string item;
+            while(std::getline(list, item, ','))
+                o.threads.push_back((int)parse_count(opt, item, 1));
+            if(o.threads.empty()) throw std::invalid_argument(opt + ": empty list");
+        } else if(opt == "-mix") {
+            /* "90" or "90/10": inserts first, the two sides must add up */
+            std::size_t slash = v.find('/');
+            o.insert_pct = (int)parse_count(opt, v.substr(0, slash), 0);
+            if(o.insert_pct > 100) throw std::invalid_argument(opt + ": more than 100%");
+            if(slash != std::string::npos &&
+               parse_count(opt, v.substr(slash + 1), 0) != 100 - o.insert_pct)
+                throw std::invalid_argument(opt + ": '" + v + "' does not add up to 100");
+        } else if(opt == "-ops") {
+            o.ops = parse_count(opt, v, 1);
+        } else if(opt == "-duration") {
+            char* end = nullptr;
+            o.duration = std::strtod(v.c_str(), &end);
+            if(v.empty() || *end != '\0' || !(o.duration > 0))
+                throw std::invalid_argument(opt + ": expected seconds > 0, got '" + v + "'");
+        } else if(opt == "-prefill") {
+            o.prefill = parse_count(opt, v, 0);
+        } else if(opt == "-warmup") {
+            o.warmup = parse_count(opt, v, 0);
+        } else if(opt == "-pin") {
+            o.pin = parse_pin_policy(v);
+        } else if(opt == "-reps") {
+            o.reps = (int)parse_count(opt, v, 1);
+        } else if(opt == "-sample") {
+            o.sample = (int)parse_count(opt, v, 1);
+        } else if(opt == "-format") {
+            if(v != "table" && v != "csv" && v != "json")
+                throw std::invalid_argument(opt + ": expected table, csv or json, got '" + v + "'");
+            o.format = v;
+        } else if(opt == "-out") {
+            o.out = v;
+        } else {
+            throw std::invalid_argument("unknown option " + opt);
+        }
+    }
+    return o;
+}
+
+void print_bench_options(std::ostream& out) {
+    out << "  -threads 1,2,4,8,16    Thread counts to run, one row each\n";
+    out << "  -mix 50/50             Percent inserts / removes, drawn per op\n";
+    out << "  -ops 100000            Ops per thread (fixed-work runs)\n";
+    out << "  -duration S            Run for S seconds instead of a fixed op count\n";
+    out << "  -prefill 10000         Items inserted before timing starts\n";
+    out << "  -warmup 10000          Untimed ops per thread before the start barrier\n";
+    out << "  -pin compact           Thread placement: none, compact, scatter or smt\n";
+    out << "  -perf                  Count cycles, instructions and cache misses per op\n";
+    out << "  -reps 1                Runs per row, reported as mean and stddev\n";
+    out << "  -sample 16             Time every Nth op for the latency percentiles\n";
+    out << "  -format table          table, csv or json\n";
+    out << "  -out FILE              Write the report to FILE instead of stdout\n";
+}
+
+/* Throughput mean and sample standard deviation over the reps, and the
+   latency histogram of all of them together */
+struct row_summary {
+    double ops, secs, mean, stddev;
+    latency_histogram lat;
+    double per_op[STAT_COUNT];          /* counters over all reps / all ops */
+};
+
+static void summarize(const bench_row& row, row_summary& s) {
+    double n = (double)row.samples.size(), sum = 0, sq = 0;
+    std::uint64_t counters[STAT_COUNT] = {};
+    s.ops = s.secs = 0;
+    s.lat.reset();
+    for(const bench_sample& b : row.samples) {
+        double tput = b.ops / b.secs;
+        sum += tput;
+        sq += tput * tput;
+        s.ops += b.ops;
+        s.secs += b.secs;
+        s.lat.merge(b.lat);
+        for(int i = 0; i < STAT_COUNT; i++) counters[i] += b.stats.v[i];
+    }
+    for(int i = 0; i < STAT_COUNT; i++)
+        s.per_op[i] = s.ops > 0 ? counters[i] / s.ops : 0.0;
+    s.mean = sum / n;
+    s.stddev = n > 1 ? std::sqrt(std::max(0.0, (sq - sum * sum / n) / (n - 1))) : 0.0;
+    s.ops /= n;
+    s.secs /= n;
+}
+
+bench_report::bench_report(const std::string& format, std::ostream& out)
+    : format(format), out(out), rows(0) {}
+
+void bench_report::add(const bench_row& row) {
+    row_summary s;
+    summarize(row, s);
+    const bench_options& o = *row.opts;
+
+    if(format == "csv") {
+        if(rows == 0) {
+            out << "container,threads,insert_pct,prefill,pin,reps,ops,secs,throughput_mean,"
+                   "throughput_stddev,lat_samples,lat_mean_ns,p50_ns,p99_ns,p999_ns,max_ns";
+            for(int i = 0; i < STAT_COUNT; i++) out << ',' << stat_names[i] << "_per_op";
+            out << '\n';
+        }
+        out << row.container << ',' << row.threads << ',' << o.insert_pct << ','
+            << o.prefill << ',' << pin_policy_name(o.pin) << ',' << row.samples.size() << ','
+            << (long long)s.ops << ',' << s.secs << ',' << s.mean << ',' << s.stddev << ',' << s.lat.count() << ','
+            << s.lat.mean() << ',' << s.lat.percentile(50) << ',' << s.lat.percentile(99) << ','
+            << s.lat.percentile(99.9) << ',' << s.lat.max();
+        for(int i = 0; i < STAT_COUNT; i++) out << ',' << s.per_op[i];
+        out << '\n';
+    } else if(format == "json") {
+        out << (rows == 0 ? "[\n" : ",\n")
+            << "  {\"container\": \"" << row.container << "\", \"threads\": " << row.threads
+            << ", \"insert_pct\": " << o.insert_pct << ", \"prefill\": " << o.prefill
+            << ", \"pin\": \"" << pin_policy_name(o.pin) << "\""
+            << ", \"reps\": " << row.samples.size() << ", \"ops\": " << (long long)s.ops
+            << ", \"secs\": " << s.secs << ", \"throughput_mean\": " << s.mean
+            << ", \"throughput_stddev\": " << s.stddev << ", \"lat_samples\": " << s.lat.count()
+            << ", \"lat_mean_ns\": " << s.lat.mean() << ", \"p50_ns\": " << s.lat.percentile(50)
+            << ", \"p99_ns\": " << s.lat.percentile(99) << ", \"p999_ns\": " << s.lat.percentile(99.9)
+            << ", \"max_ns\": " << s.lat.max();
+        for(int i = 0; i < STAT_COUNT; i++)
+            out << ", \"" << stat_names[i] << "_per_op\": " << s.per_op[i];
+        out << "}";
+    } else {
+        if(rows == 0)
+            out << "=== " << row.container << "  mix=" << o.insert_pct << "/" << 100 - o.insert_pct
+                << "  prefill=" << o.prefill << "  pin=" << pin_policy_name(o.pin) << " ===\n";
+        out << "  " << row.container << "  threads=" << row.threads
+            << "  ops=" << (long long)s.ops
+            << "  throughput=" << s.mean << " ops/s";
+        if(row.samples.size() > 1)
+            out << " (sd " << (s.mean > 0 ? 100.0 * s.stddev / s.mean : 0.0) << "%)";
+        out << "  p50=" << s.lat.percentile(50) << "ns"
+            << "  p99=" << s.lat.percentile(99) << "ns"
+            << "  p99.9=" << s.lat.percentile(99.9) << "ns"
+            << "  max=" << s.lat.max() << "ns";
+        /* Only the counters this container touched */
+        for(int i = 0; i < STAT_COUNT; i++)
+            if(s.per_op[i] > 0) out << "  " << stat_names[i] << "/op=" << s.per_op[i];
+        out << "\n";
+    }
+    out.flush();
+    rows++;
+}
+
+void bench_report::finish() {
+    if(format == "json") out << (rows == 0 ? "[]\n" : "\n]\n");
+}
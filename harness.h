@@ -0,0 +1,73 @@
+/*
+ * harness.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Options and result reporting of the benchmark harness.
+ *
+ * A harness run drives one container with a random insert/remove mix:
+ *   bench_options o = parse_bench_options(argc, argv, first);
+ *   bench_report rep(o.format, out);
+ *   rep.add(row) once per thread count, then rep.finish()
+ * The workload itself is a template over the container, see main.cpp.
+ */
+
+#ifndef HARNESS_H
+#define HARNESS_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include "histogram.h"
+#include "affinity.h"
+#include "stats.h"
+
+/* Command-line options, defaults reproduce the old fixed benchmarks */
+struct bench_options {
+    std::vector<int> threads{1, 2, 4, 8, 16};
+    int insert_pct = 50;                /* percent of ops that insert, rest remove */
+    long ops = 100000;                  /* per thread, unless duration is set */
+    double duration = 0;                /* seconds per run, 0 counts ops instead */
+    long prefill = 10000;               /* items inserted before the clock starts */
+    long warmup = 10000;                /* untimed ops per thread before the start barrier */
+    pin_policy pin = PIN_COMPACT;       /* placement of the worker threads */
+    bool perf = false;                  /* hardware counters, see perf.h */
+    int reps = 1;                       /* runs per thread count */
+    int sample = 16;                    /* time every sample-th op */
+    std::string format = "table";       /* table, csv or json */
+    std::string out;                    /* output file, empty for stdout */
+};
+
+/* Parse argv[first..argc) over defaults, throws std::invalid_argument */
+bench_options parse_bench_options(int argc, char** argv, int first,
+                                  const bench_options& defaults = bench_options());
+
+/* Usage lines for the options above */
+void print_bench_options(std::ostream& out);
+
+/* One measured run */
+struct bench_sample {
+    long long ops;
+    double secs;
+    latency_histogram lat;
+    stats_snapshot stats;               /* counters of the timed phase */
+};
+
+/* Every rep of one container at one thread count */
+struct bench_row {
+    std::string container;
+    int threads;
+    const bench_options* opts;
+    std::vector<bench_sample> samples;
+};
+
+class bench_report {
+    std::string format;
+    std::ostream& out;
+    int rows;
+public:
+    bench_report(const std::string& format, std::ostream& out);
+    void add(const bench_row& row);
+    void finish();
+};
+
+#endif
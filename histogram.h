@@ -0,0 +1,85 @@
+/*
+ * histogram.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Log-linear latency histogram in the style of HdrHistogram.
+ *
+ * Values below 2^HIST_SUB_BITS are counted exactly. Above that every
+ * power of two is split into 2^HIST_SUB_BITS equal buckets, so a reported
+ * percentile is within 1/32 (about 3%) of the true value at any scale,
+ * from nanoseconds to minutes, in a fixed 15 KB table per thread.
+ */
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+#define HIST_SUB_BITS 5
+
+class latency_histogram {
+    static const std::size_t SUB = (std::size_t)1 << HIST_SUB_BITS;
+    static const std::size_t BUCKETS = (64 - HIST_SUB_BITS + 1) * SUB;
+
+    std::uint64_t counts[BUCKETS];
+    std::uint64_t total;
+    std::uint64_t sum;
+    std::uint64_t largest;
+
+    static std::size_t index_of(std::uint64_t v) {
+        if(v < SUB) return (std::size_t)v;
+        int shift = 63 - __builtin_clzll(v) - HIST_SUB_BITS;
+        return (std::size_t)(shift + 1) * SUB + (std::size_t)((v >> shift) - SUB);
+    }
+
+    /* Midpoint of the values that land in bucket i */
+    static std::uint64_t value_of(std::size_t i) {
+        if(i < SUB) return i;
+        int shift = (int)(i / SUB) - 1;
+        std::uint64_t low = (std::uint64_t)(i % SUB + SUB) << shift;
+        return low + (((std::uint64_t)1 << shift) >> 1);
+    }
+
+public:
+    latency_histogram() { reset(); }
+
+    void reset() {
+        for(std::uint64_t& c : counts) c = 0;
+        total = sum = largest = 0;
+    }
+
+    void record(std::uint64_t v) {
+        counts[index_of(v)]++;
+        total++;
+        sum += v;
+        if(v > largest) largest = v;
+    }
+
+    void merge(const latency_histogram& o) {
+        for(std::size_t i = 0; i < BUCKETS; i++) counts[i] += o.counts[i];
+        total += o.total;
+        sum += o.sum;
+        if(o.largest > largest) largest = o.largest;
+    }
+
+    std::uint64_t count() const { return total; }
+    std::uint64_t max() const { return largest; }
+    double mean() const { return total ? (double)sum / total : 0.0; }
+
+    /* Value that p percent of the samples do not exceed, to bucket precision */
+    std::uint64_t percentile(double p) const {
+        if(total == 0) return 0;
+        std::uint64_t rank = (std::uint64_t)std::ceil(p / 100.0 * total);
+        if(rank < 1) rank = 1;
+        std::uint64_t seen = 0;
+        for(std::size_t i = 0; i < BUCKETS; i++) {
+            seen += counts[i];
+            if(seen >= rank) return value_of(i) < largest ? value_of(i) : largest;
+        }
+        return largest;
+    }
+};
+
+#endif
@@ -5,6 +5,10 @@
  */
 
 #include "containers.h"
+#include "harness.h"
+#include "affinity.h"
+#include "perf.h"
+#include "stress.h"
 #include <iostream>
 #include <thread>
 #include <cassert>
@@ -12,13 +16,23 @@
 #include <vector>
 #include <string>
 #include <atomic>
+#include <optional>
+#include <memory>
+#include <type_traits>
+#include <fstream>
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <cstring>
+#include <unistd.h>
+#include <sys/resource.h>
 
 using namespace std;
 
 /* Basic correctness tests */
 void test_sgl_stack() {
     cout << "Testing SGL Stack... ";
-    sgl_stack s;
+    sgl_stack<int> s;
     s.push(1); s.push(2); s.push(3);
     assert(s.pop() == 3 && s.pop() == 2 && s.pop() == 1);
     cout << "PASS" << endl;
@@ -26,7 +40,7 @@ void test_sgl_stack() {
 
 void test_sgl_queue() {
     cout << "Testing SGL Queue... ";
-    sgl_queue q;
+    sgl_queue<int> q;
     q.enqueue(1); q.enqueue(2); q.enqueue(3);
     assert(q.dequeue() == 1 && q.dequeue() == 2 && q.dequeue() == 3);
     cout << "PASS" << endl;
@@ -34,7 +48,7 @@ void test_sgl_queue() {
 
 void test_treiber() {
     cout << "Testing Treiber Stack... ";
-    treiber_stack s;
+    treiber_stack<int> s;
     s.push(1); s.push(2); s.push(3);
     assert(s.pop() == 3 && s.pop() == 2 && s.pop() == 1);
     cout << "PASS" << endl;
@@ -42,7 +56,7 @@ void test_treiber() {
 
 void test_msqueue() {
     cout << "Testing M&S Queue... ";
-    msqueue q;
+    msqueue<int> q;
     q.enqueue(1); q.enqueue(2); q.enqueue(3);
     assert(q.dequeue() == 1 && q.dequeue() == 2 && q.dequeue() == 3);
     cout << "PASS" << endl;
@@ -50,7 +64,7 @@ void test_msqueue() {
 
 void test_elimination() {
     cout << "Testing Elimination Stack... ";
-    elimination_stack s;
+    elimination_stack<int> s;
     s.push(1); s.push(2); s.push(3);
     assert(s.pop() == 3 && s.pop() == 2 && s.pop() == 1);
     cout << "PASS" << endl;
@@ -58,145 +72,2112 @@ void test_elimination() {
 
 void test_fc_stack() {
     cout << "Testing FC Stack... ";
-    fc_stack s;
+    fc_stack<int> s;
     s.push(1); s.push(2); s.push(3);
     assert(s.pop() == 3 && s.pop() == 2 && s.pop() == 1);
+
+    /* One thread alternating between more stacks than its record cache holds */
+    vector<unique_ptr<fc_stack<int>>> many;
+    for(int i = 0; i < INSTANCE_CACHE + 1; i++) many.emplace_back(new fc_stack<int>());
+    for(int round = 0; round < 3; round++)
+        for(size_t i = 0; i < many.size(); i++) many[i]->push(round * 100 + (int)i);
+    for(size_t i = 0; i < many.size(); i++)
+        for(int round = 2; round >= 0; round--) assert(many[i]->pop() == round * 100 + (int)i);
+    cout << "PASS" << endl;
+}
+
+void test_fc_queue() {
+    cout << "Testing FC Queue... ";
+    fc_queue<int> q;
+    q.enqueue(1); q.enqueue(2); q.enqueue(3);
+    assert(q.dequeue() == 1 && q.dequeue() == 2 && q.dequeue() == 3);
+
+    /* One thread alternating between more queues than its handle cache holds */
+    vector<unique_ptr<fc_queue<int>>> many;
+    for(int i = 0; i < INSTANCE_CACHE + 1; i++) many.emplace_back(new fc_queue<int>());
+    for(int round = 0; round < 3; round++)
+        for(size_t i = 0; i < many.size(); i++) many[i]->enqueue(round * 100 + (int)i);
+    for(size_t i = 0; i < many.size(); i++)
+        for(int round = 0; round < 3; round++) assert(many[i]->dequeue() == round * 100 + (int)i);
+    cout << "PASS" << endl;
+}
+
+/* Concurrent pushes and pops must neither lose nor invent values,
+   whether they go through the stack or the exchanger */
+void test_elimination_concurrent() {
+    cout << "Testing Elimination Exchange... ";
+    elimination_stack<int> s;
+    const int threads = 4, per_thread = 20000;
+    atomic<long long> popped_sum(0);
+    atomic<int> popped(0);
+
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            int v;
+            for(int i = 0; i < per_thread; i++) {
+                s.push(t * per_thread + i);
+                if(s.try_pop(v)) {
+                    popped_sum += v;
+                    popped++;
+                }
+            }
+        });
+    }
+    for(auto& th : ts) th.join();
+    while(optional<int> v = s.try_pop()) {
+        popped_sum += *v;
+        popped++;
+    }
+    long long n = 1LL * threads * per_thread;
+    assert(popped == n && popped_sum == n * (n - 1) / 2);
+    cout << "PASS" << endl;
+}
+
+/* Every start mode keeps LIFO order and loses nothing under contention,
+   and a lone thread walks the mode back down to plain Treiber */
+void test_adaptive() {
+    cout << "Testing Adaptive Stack... ";
+    for(adapt_mode start : {ADAPT_TREIBER, ADAPT_ELIMINATION, ADAPT_COMBINING}) {
+        adaptive_stack<int> s(start);
+        assert(s.mode() == start);
+        s.push(1); s.push(2); s.push(3);
+        assert(s.pop() == 3 && s.pop() == 2 && s.pop() == 1 && !s.try_pop());
+
+        const int threads = 4, per_thread = 20000;
+        atomic<long long> sum(0);
+        atomic<int> count(0);
+        vector<thread> ts;
+        for(int t = 0; t < threads; t++) {
+            ts.emplace_back([&, t]() {
+                int v;
+                for(int i = 0; i < per_thread; i++) {
+                    s.push(t * per_thread + i);
+                    if(i % 2 && s.try_pop(v)) {
+                        sum += v;
+                        count++;
+                    }
+                }
+            });
+        }
+        for(auto& th : ts) th.join();
+        int v;
+        while(s.try_pop(v)) {
+            sum += v;
+            count++;
+        }
+        long long n = 1LL * threads * per_thread;
+        assert(count == n && sum == n * (n - 1) / 2);
+    }
+
+    adaptive_stack<int> s(ADAPT_COMBINING);
+    for(int i = 0; i < 4 * ADAPT_WINDOW; i++) {
+        s.push(i);
+        assert(s.pop() == i);
+    }
+    assert(s.mode() == ADAPT_TREIBER);
+    cout << "PASS" << endl;
+}
+
+/* Bulk APIs keep the same order as the single-item ones */
+template<typename Stack>
+static void check_stack_bulk() {
+    Stack s;
+    int in[100], out[100];
+    for(int i = 0; i < 100; i++) in[i] = i;
+    s.push_n(in, 100);
+    s.push(100);
+    assert(s.pop() == 100);
+    assert(s.pop_n(out, 10) == 10 && out[0] == 99 && out[9] == 90);
+    assert(s.pop_n(out, 100) == 90 && out[0] == 89 && out[89] == 0);
+    assert(s.pop_n(out, 1) == 0);
+}
+
+template<typename Queue>
+static void check_queue_bulk() {
+    Queue q;
+    int in[100], out[100];
+    for(int i = 0; i < 100; i++) in[i] = i;
+    q.enqueue_bulk(in, 50);
+    q.enqueue(50);
+    q.enqueue_bulk(in + 51, 49);
+    assert(q.dequeue() == 0);
+    assert(q.dequeue_bulk(out, 10) == 10 && out[0] == 1 && out[9] == 10);
+    assert(q.dequeue_bulk(out, 100) == 89 && out[0] == 11 && out[88] == 99);
+    assert(q.dequeue_bulk(out, 1) == 0);
+}
+
+void test_bulk() {
+    cout << "Testing Bulk APIs... ";
+    check_stack_bulk<sgl_stack<int>>();
+    check_stack_bulk<treiber_stack<int>>();
+    check_stack_bulk<elimination_stack<int>>();
+    check_stack_bulk<fc_stack<int>>();
+    check_stack_bulk<adaptive_stack<int>>();
+    check_stack_bulk<sharded_stack<treiber_stack<int>>>();
+    check_queue_bulk<sgl_queue<int>>();
+    check_queue_bulk<msqueue<int>>();
+    check_queue_bulk<faa_queue<int>>();
+    check_queue_bulk<fc_queue<int>>();
+    check_queue_bulk<sharded_queue<msqueue<int>>>();
+    cout << "PASS" << endl;
+}
+
+/* Empty is reported without exceptions, and -1 is an ordinary value */
+template<typename Stack>
+static void check_try_pop() {
+    Stack s;
+    int v = 7;
+    assert(!s.try_pop(v) && v == 7 && !s.try_pop());
+    s.push(-1);
+    s.push(5);
+    assert(s.try_pop(v) && v == 5);
+    assert(s.try_pop() == optional<int>(-1));
+    bool threw = false;
+    try { s.pop(); } catch(const runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+template<typename Queue>
+static void check_try_dequeue() {
+    Queue q;
+    int v = 7;
+    assert(!q.try_dequeue(v) && v == 7 && !q.try_dequeue());
+    q.enqueue(-1);
+    q.enqueue(5);
+    assert(q.try_dequeue() == optional<int>(-1));
+    assert(q.try_dequeue(v) && v == 5);
+    assert(!q.try_dequeue());
+}
+
+void test_try_pop() {
+    cout << "Testing try_pop/try_dequeue... ";
+    check_try_pop<sgl_stack<int>>();
+    check_try_pop<treiber_stack<int>>();
+    check_try_pop<elimination_stack<int>>();
+    check_try_pop<fc_stack<int>>();
+    check_try_pop<adaptive_stack<int>>();
+    check_try_pop<sharded_stack<sgl_stack<int>>>();
+    check_try_dequeue<sgl_queue<int>>();
+    check_try_dequeue<msqueue<int>>();
+    check_try_dequeue<faa_queue<int>>();
+    check_try_dequeue<fc_queue<int>>();
+    check_try_dequeue<bounded_queue<int>>();
+    check_try_dequeue<sharded_queue<sgl_queue<int>>>();
+    cout << "PASS" << endl;
+}
+
+/* Move-only value that counts the live objects it owns, so a container
+   that leaks or destroys a value twice shows up */
+struct tracked {
+    static atomic<int> live;
+    int v;
+    bool owns;
+    tracked() : v(0), owns(false) {}
+    explicit tracked(int x) : v(x), owns(true) { live++; }
+    tracked(tracked&& o) noexcept : v(o.v), owns(o.owns) { o.owns = false; }
+    tracked& operator=(tracked&& o) noexcept {
+        if(owns) live--;
+        v = o.v;
+        owns = o.owns;
+        o.owns = false;
+        return *this;
+    }
+    ~tracked() { if(owns) live--; }
+};
+atomic<int> tracked::live(0);
+
+/* 64-byte trivially-copyable payload, too big to travel inline */
+struct pod64 {
+    int v;
+    char pad[60];
+};
+
+template<typename Stack>
+static void check_move_only_stack() {
+    {
+        Stack s;
+        for(int i = 0; i < 100; i++) s.emplace(i);
+        s.push(tracked(100));
+        assert(s.pop().v == 100);
+        for(int i = 99; i >= 50; i--) assert(s.pop().v == i);
+        optional<tracked> o = s.try_pop();
+        assert(o && o->v == 49);
+    }
+    assert(tracked::live == 0);
+}
+
+template<typename Queue>
+static void check_move_only_queue() {
+    {
+        Queue q;
+        for(int i = 0; i < 40; i++) q.emplace(i);
+        q.enqueue(tracked(40));
+        for(int i = 0; i < 20; i++) assert(q.dequeue().v == i);
+        optional<tracked> o = q.try_dequeue();
+        assert(o && o->v == 20);
+    }
+    assert(tracked::live == 0);
+}
+
+template<typename Queue>
+static void check_pod_queue() {
+    Queue q;
+    for(int i = 0; i < 10; i++) {
+        pod64 p = {};
+        p.v = i;
+        p.pad[59] = (char)i;
+        q.enqueue(p);
+    }
+    for(int i = 0; i < 10; i++) {
+        pod64 p = q.dequeue();
+        assert(p.v == i && p.pad[59] == (char)i);
+    }
+}
+
+void test_generic() {
+    cout << "Testing Generic Values... ";
+    check_move_only_stack<sgl_stack<tracked>>();
+    check_move_only_stack<treiber_stack<tracked>>();
+    check_move_only_stack<treiber_stack<tracked, epoch_based>>();
+    check_move_only_stack<elimination_stack<tracked>>();
+    check_move_only_stack<fc_stack<tracked>>();
+    check_move_only_stack<adaptive_stack<tracked>>();
+    check_move_only_stack<sharded_stack<treiber_stack<tracked>>>();
+    check_move_only_queue<sgl_queue<tracked>>();
+    check_move_only_queue<msqueue<tracked>>();
+    check_move_only_queue<msqueue<tracked, epoch_based>>();
+    check_move_only_queue<faa_queue<tracked>>();
+    check_move_only_queue<fc_queue<tracked>>();
+    check_move_only_queue<bounded_queue<tracked>>();
+    check_move_only_queue<sharded_queue<msqueue<tracked>>>();
+    check_pod_queue<msqueue<pod64>>();
+    check_pod_queue<faa_queue<pod64>>();
+    check_pod_queue<fc_queue<pod64>>();
+
+    fc_stack<unique_ptr<int>> s;
+    s.push(make_unique<int>(1));
+    s.emplace(new int(2));
+    assert(*s.pop() == 2 && *s.pop() == 1 && !s.try_pop());
+    cout << "PASS" << endl;
+}
+
+/* FAA queue: FIFO across segment boundaries, and every producer's order
+   kept under concurrent producers and consumers */
+template<typename Queue>
+static void check_faa_queue() {
+    Queue q;
+    const int n = 3 * FAA_SEGMENT + 7;
+    for(int round = 0; round < 3; round++) {
+        for(int i = 0; i < n; i++) q.enqueue(i);
+        for(int i = 0; i < n; i++) assert(q.dequeue() == i);
+        assert(!q.try_dequeue());
+    }
+
+    const int threads = 4, per_thread = 20000;
+    atomic<long long> sum(0);
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            for(int i = 0; i < per_thread; i++) q.enqueue(t * per_thread + i);
+        });
+        ts.emplace_back([&]() {
+            vector<int> last(threads, -1);
+            for(int got = 0; got < per_thread; ) {
+                int v;
+                if(!q.try_dequeue(v)) continue;
+                assert(v > last[v / per_thread]);
+                last[v / per_thread] = v;
+                sum += v;
+                got++;
+            }
+        });
+    }
+    for(auto& th : ts) th.join();
+    long long total = 1LL * threads * per_thread;
+    assert(sum == total * (total - 1) / 2 && !q.try_dequeue());
+}
+
+void test_faa_queue() {
+    cout << "Testing FAA Queue... ";
+    check_faa_queue<faa_queue<int>>();
+    check_faa_queue<faa_queue<int, epoch_based, pool_alloc>>();
+    check_faa_queue<faa_queue<int, hazard_pointers, freelist_alloc, packed_layout>>();
+    {
+        faa_queue<tracked> q;
+        for(int i = 0; i < FAA_SEGMENT + 10; i++) q.emplace(i);
+        for(int i = 0; i < 5; i++) assert(q.dequeue().v == i);
+    }
+    assert(tracked::live == 0);
+    cout << "PASS" << endl;
+}
+
+/* Min-priority order for one thread, stability under duplicates and a
+   reversed comparison; then concurrent pushes and pops lose nothing and
+   what is left drains in order */
+template<typename PQ, typename MaxPQ>
+static void check_priority_queue() {
+    PQ pq;
+    vector<int> keys(1000);
+    for(int i = 0; i < 1000; i++) keys[i] = (i * 7919) % 500;     /* every key twice */
+    for(int k : keys) pq.push(k);
+    for(int i = 0; i < 1000; i++) assert(pq.pop() == i / 2);
+    assert(!pq.try_pop());
+
+    MaxPQ maxpq;
+    int in[5] = {3, 9, 1, 7, 5}, out[5];
+    maxpq.push_n(in, 5);
+    assert(maxpq.pop_n(out, 5) == 5 && out[0] == 9 && out[4] == 1);
+
+    const int threads = 4, per_thread = 20000;
+    atomic<long long> sum(0);
+    atomic<int> count(0);
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            int v;
+            for(int i = 0; i < per_thread; i++) {
+                pq.push((t * per_thread + i) * 7919 % (threads * per_thread));
+                if(i % 3 == 0 && pq.try_pop(v)) {
+                    sum += v;
+                    count++;
+                }
+            }
+        });
+    }
+    for(auto& th : ts) th.join();
+    int prev = -1, v;
+    while(pq.try_pop(v)) {
+        assert(v >= prev);
+        prev = v;
+        sum += v;
+        count++;
+    }
+    long long n = 1LL * threads * per_thread;
+    assert(count == n && sum == n * (n - 1) / 2);
+}
+
+void test_priority_queue() {
+    cout << "Testing Priority Queues... ";
+    check_priority_queue<skiplist_pq<int>, skiplist_pq<int, greater<int>>>();
+    check_priority_queue<fc_heap<int>, fc_heap<int, greater<int>>>();
+    check_priority_queue<fc_heap<int, less<int>, padded_layout, exp_backoff, sim_topology<2>>,
+                         fc_heap<int, greater<int>, padded_layout, exp_backoff, sim_topology<2>>>();
+    cout << "PASS" << endl;
+}
+
+/* Map semantics, then threads racing on the same keys: every shared key
+   is either in the map or was erased once per successful insert, while
+   lookups of disjoint per-thread keys always see their own writes */
+template<typename Map>
+static void check_map() {
+    Map m;
+    for(int i = 0; i < 1000; i++) assert(m.insert(i, 2 * i));
+    assert(!m.insert(7, 0) && m.size() == 1000);
+    int v;
+    assert(m.find(7, v) && v == 14 && m.find(999) == optional<int>(1998));
+    assert(!m.find(1000, v) && !m.find(-1));
+    for(int i = 1; i < 1000; i += 2) assert(m.erase(i));
+    assert(!m.erase(1) && m.size() == 500);
+    for(int i = 0; i < 1000; i++) assert(m.contains(i) == (i % 2 == 0));
+
+    const int threads = 4, keys = 2000;
+    atomic<int> inserted(0), erased(0);
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            for(int k = 0; k < keys; k++) {
+                if(m.insert(10000 + k, k)) inserted++;
+                int own = 100000 + t * keys + k;
+                assert(m.insert(own, t));
+                int got;
+                assert(m.find(own, got) && got == t);
+            }
+            for(int k = 0; k < keys; k++) {
+                if(m.erase(10000 + k)) erased++;
+                if(k % 2) assert(m.erase(100000 + t * keys + k));
+            }
+        });
+    }
+    for(auto& th : ts) th.join();
+    int left = 0;
+    for(int k = 0; k < keys; k++) left += m.contains(10000 + k);
+    assert(inserted >= keys && inserted - erased == left);
+    assert(m.size() == 500 + (size_t)threads * keys / 2 + left);
+    for(int t = 0; t < threads; t++)
+        for(int k = 0; k < keys; k++) assert(m.contains(100000 + t * keys + k) == (k % 2 == 0));
+}
+
+void test_map() {
+    cout << "Testing Hash Maps... ";
+    check_map<sgl_map<int, int>>();
+    check_map<split_ordered_map<int, int>>();
+    check_map<split_ordered_map<int, int, hash<int>, epoch_based>>();
+    check_map<split_ordered_map<int, int, hash<int>, hazard_pointers, pool_alloc>>();
+
+    /* Buckets double as the map fills and split without moving items */
+    split_ordered_map<int, int> m(2);
+    for(int i = 0; i < 10000; i++) m.insert(i, i);
+    assert(m.bucket_count() >= 10000 / MAP_LOAD);
+    for(int i = 0; i < 10000; i++) assert(m.find(i) == optional<int>(i));
+    split_ordered_map<string, string> s;
+    assert(s.insert("key", "value") && s.find("key") == optional<string>("value"));
+    bool threw = false;
+    try { split_ordered_map<int, int> bad(3); } catch(const invalid_argument&) { threw = true; }
+    assert(threw);
+    cout << "PASS" << endl;
+}
+
+/* Uniform insert/remove, so one test or benchmark covers stacks and
+   queues */
+template<typename C, typename V>
+static auto insert_item(C& c, V v) -> decltype(c.push(v)) { c.push(v); }
+template<typename C, typename V>
+static auto insert_item(C& c, V v) -> decltype(c.enqueue(v)) { c.enqueue(v); }
+template<typename C, typename V>
+static auto remove_item(C& c, V& v) -> decltype(c.try_pop(v)) { return c.try_pop(v); }
+template<typename C, typename V>
+static auto remove_item(C& c, V& v) -> decltype(c.try_dequeue(v)) { return c.try_dequeue(v); }
+
+/* Insert that may fail: bounded containers report full, the rest always
+   succeed */
+template<typename C, typename V>
+static auto try_insert(C& c, V v, int) -> decltype(c.try_enqueue(v)) { return c.try_enqueue(v); }
+template<typename C, typename V>
+static bool try_insert(C& c, V v, long) { insert_item(c, v); return true; }
+
+/* Blocking pops: a timed pop on an empty container gives up after its
+   timeout, and consumers asleep before the producers start get every item */
+template<typename C, typename Wait, typename WaitFor>
+static void check_wait(Wait wait, WaitFor wait_for) {
+    C c;
+    auto start = chrono::steady_clock::now();
+    assert(!wait_for(c, chrono::milliseconds(20)));
+    assert(chrono::steady_clock::now() - start >= chrono::milliseconds(20));
+
+    const int threads = 2, per_thread = 5000;
+    atomic<long long> sum(0);
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&]() {
+            for(int i = 0; i < per_thread; i++) sum += wait(c);
+        });
+    }
+    this_thread::sleep_for(chrono::milliseconds(20));
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            for(int i = 0; i < per_thread; i++) insert_item(c, t * per_thread + i);
+        });
+    }
+    for(auto& th : ts) th.join();
+    long long n = 1LL * threads * per_thread;
+    assert(sum == n * (n - 1) / 2);
+
+    insert_item(c, 7);
+    assert(wait_for(c, chrono::seconds(10)) == optional<int>(7));
+}
+
+void test_blocking_pop() {
+    cout << "Testing Blocking Pops... ";
+    auto pop = [](auto& s) { return s.pop_wait(); };
+    auto pop_for = [](auto& s, auto timeout) { return s.pop_for(timeout); };
+    auto deq = [](auto& q) { return q.dequeue_wait(); };
+    auto deq_for = [](auto& q, auto timeout) { return q.dequeue_for(timeout); };
+    check_wait<treiber_stack<int>>(pop, pop_for);
+    check_wait<elimination_stack<int>>(pop, pop_for);
+    check_wait<adaptive_stack<int>>(pop, pop_for);
+    check_wait<msqueue<int>>(deq, deq_for);
+    check_wait<faa_queue<int>>(deq, deq_for);
+    cout << "PASS" << endl;
+}
+
+/* Sharded containers: each thread fills its own shard, others steal
+   from it, and nothing is lost or reported empty while any shard has
+   items */
+template<typename C>
+static void check_sharded() {
+    C c(4);
+    const int threads = 4, per_thread = 5000;
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            for(int i = 0; i < per_thread; i++) insert_item(c, t * per_thread + i);
+        });
+    }
+    for(auto& th : ts) th.join();
+    ts.clear();
+
+    atomic<long long> sum(0), count(0);
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&]() {
+            int v;
+            while(remove_item(c, v)) { sum += v; count++; }
+        });
+    }
+    for(auto& th : ts) th.join();
+    long long n = 1LL * threads * per_thread;
+    int v;
+    assert(count == n && sum == n * (n - 1) / 2 && !remove_item(c, v));
+}
+
+void test_sharded() {
+    cout << "Testing Sharded Containers... ";
+    bool threw = false;
+    try { sharded_stack<treiber_stack<int>> bad(0); } catch(const invalid_argument&) { threw = true; }
+    assert(threw);
+    check_sharded<sharded_stack<treiber_stack<int>>>();
+    check_sharded<sharded_queue<msqueue<int>>>();
+    check_sharded<sharded_queue<sgl_queue<int>>>();
+
+    /* Items left in the shard of a thread that has exited are stolen, in
+       that shard's order */
+    sharded_queue<msqueue<int>> q(8);
+    thread producer([&]() { for(int i = 0; i < 100; i++) q.enqueue(i); });
+    producer.join();
+    for(int i = 0; i < 100; i++) assert(q.dequeue() == i);
+    assert(!q.try_dequeue() && q.shard_count() == 8);
+    cout << "PASS" << endl;
+}
+
+/* Deque: owner LIFO and thief FIFO across growth, and under concurrent
+   thieves every item is taken exactly once */
+void test_ws_deque() {
+    cout << "Testing Work-Stealing Deque... ";
+    bool threw = false;
+    try { ws_deque<int> bad(3); } catch(const invalid_argument&) { threw = true; }
+    assert(threw);
+
+    ws_deque<int> d(4);
+    for(int i = 0; i < 200; i++) d.push_bottom(i);
+    assert(d.capacity() == 256);
+    for(int i = 0; i < 100; i++) {
+        assert(d.pop_bottom() == optional<int>(199 - i));
+        assert(d.steal() == optional<int>(i));
+    }
+    assert(!d.pop_bottom() && !d.steal());
+
+    ws_deque<int> w(8);
+    const int n = 100000, thieves = 3;
+    vector<atomic<int>> taken(n);
+    atomic<bool> done(false);
+    vector<thread> ts;
+    for(int t = 0; t < thieves; t++) {
+        ts.emplace_back([&]() {
+            int v;
+            while(!done.load()) {
+                if(w.steal(v)) taken[v]++;
+            }
+        });
+    }
+    for(int i = 0; i < n; i++) {
+        w.push_bottom(i);
+        int v;
+        if(i % 3 == 0 && w.pop_bottom(v)) taken[v]++;
+    }
+    int v;
+    while(w.pop_bottom(v)) taken[v]++;
+    done = true;
+    for(auto& th : ts) th.join();
+    for(int i = 0; i < n; i++) assert(taken[i] == 1);
+    cout << "PASS" << endl;
+}
+
+/* Ring: FIFO across laps, exact capacity, and no lost or duplicated
+   values between concurrent producers and consumers */
+void test_mpmc_ring() {
+    cout << "Testing MPMC Ring... ";
+    bool threw = false;
+    try { mpmc_ring<int> bad(48); } catch(const invalid_argument&) { threw = true; }
+    assert(threw);
+
+    mpmc_ring<int> r(8);
+    for(int lap = 0; lap < 5; lap++) {
+        for(int i = 0; i < 8; i++) assert(r.try_enqueue(lap * 8 + i));
+        assert(!r.try_enqueue(-1));
+        for(int i = 0; i < 8; i++) assert(r.try_dequeue() == optional<int>(lap * 8 + i));
+        assert(!r.try_dequeue());
+    }
+
+    {
+        mpmc_ring<tracked> m(4);
+        for(int i = 0; i < 3; i++) assert(m.try_emplace(i));
+        assert(m.dequeue().v == 0);
+    }
+    assert(tracked::live == 0);
+
+    mpmc_ring<int, packed_layout> q(16);
+    const int threads = 4, per_thread = 20000;
+    atomic<long long> sum(0);
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            for(int i = 0; i < per_thread; i++) q.enqueue(t * per_thread + i);
+        });
+        ts.emplace_back([&]() {
+            for(int i = 0; i < per_thread; i++) sum += q.dequeue();
+        });
+    }
+    for(auto& th : ts) th.join();
+    long long n = 1LL * threads * per_thread;
+    assert(sum == n * (n - 1) / 2 && !q.try_dequeue());
+    cout << "PASS" << endl;
+}
+
+/* Intrusive node for the MPSC queue */
+struct job : mpsc_hook {
+    int id;
+    explicit job(int i) : id(i) {}
+};
+
+/* SPSC keeps one producer's order; MPSC keeps every producer's order */
+void test_spsc_mpsc() {
+    cout << "Testing SPSC/MPSC Queues... ";
+    spsc_ring<int> r(4);
+    for(int lap = 0; lap < 5; lap++) {
+        for(int i = 0; i < 4; i++) assert(r.try_enqueue(lap * 4 + i));
+        assert(!r.try_enqueue(-1));
+        for(int i = 0; i < 4; i++) assert(r.dequeue() == lap * 4 + i);
+        assert(!r.try_dequeue());
+    }
+
+    spsc_ring<int> pipe(64);
+    const int per_thread = 50000;
+    thread producer([&]() {
+        for(int i = 0; i < per_thread; i++) pipe.enqueue(i);
+    });
+    for(int i = 0; i < per_thread; i++) assert(pipe.dequeue() == i);
+    producer.join();
+
+    job a(1), b(2), c(3);
+    intrusive_mpsc<job> jobs;
+    assert(!jobs.pop());
+    jobs.push(&a); jobs.push(&b);
+    assert(jobs.pop() == &a);
+    jobs.push(&c);
+    assert(jobs.pop() == &b && jobs.pop() == &c && !jobs.pop());
+
+    mpsc_queue<int> q;
+    const int threads = 4;
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            for(int i = 0; i < per_thread; i++) q.enqueue(t * per_thread + i);
+        });
+    }
+    vector<int> last(threads, -1);
+    for(long long got = 0; got < 1LL * threads * per_thread; ) {
+        int v;
+        if(!q.try_dequeue(v)) continue;
+        int t = v / per_thread;
+        assert(v > last[t]);
+        last[t] = v;
+        got++;
+    }
+    for(auto& th : ts) th.join();
+    assert(!q.try_dequeue());
+
+    {
+        spsc_ring<tracked> sr(8);
+        mpsc_queue<tracked> mq;
+        for(int i = 0; i < 5; i++) { sr.try_emplace(i); mq.emplace(i); }
+        assert(sr.dequeue().v == 0 && mq.dequeue().v == 0);
+    }
+    assert(tracked::live == 0);
+    cout << "PASS" << endl;
+}
+
+/* Every reclamation policy must hand back the same values */
+template<typename Reclaim>
+static void check_reclaim() {
+    treiber_stack<int, Reclaim> s;
+    msqueue<int, Reclaim> q;
+    for(int round = 0; round < 100; round++) {
+        for(int i = 0; i < 100; i++) { s.push(i); q.enqueue(i); }
+        for(int i = 99; i >= 0; i--) assert(s.pop() == i);
+        for(int i = 0; i < 100; i++) assert(q.dequeue() == i);
+    }
+}
+
+void test_reclaim() {
+    cout << "Testing Reclamation Policies... ";
+    check_reclaim<hazard_pointers>();
+    check_reclaim<epoch_based>();
+    check_reclaim<no_reclaim>();
+    cout << "PASS" << endl;
+}
+
+/* Tagged pointers let popped nodes be reused straight away */
+template<template<typename> class Ptr>
+static void check_tagged() {
+    treiber_stack<int, immediate_reclaim, Ptr, freelist_alloc> s;
+    msqueue<int, immediate_reclaim, Ptr, freelist_alloc> q;
+    for(int round = 0; round < 100; round++) {
+        for(int i = 0; i < 100; i++) { s.push(i); q.enqueue(i); }
+        for(int i = 99; i >= 0; i--) assert(s.pop() == i);
+        for(int i = 0; i < 100; i++) assert(q.dequeue() == i);
+    }
+}
+
+void test_tagged() {
+    cout << "Testing Tagged Pointers... ";
+    check_tagged<packed_ptr>();
+#ifdef HAVE_DWCAS
+    check_tagged<dwcas_ptr>();
+#endif
+    cout << "PASS" << endl;
+}
+
+/* Nodes freed by another thread go back to the cache that carved them */
+void test_pool_alloc() {
+    cout << "Testing Pool Allocator... ";
+    treiber_stack<int, hazard_pointers, plain_ptr, pool_alloc> s;
+    thread producer([&]() {
+        for(int i = 0; i < 1000; i++) s.push(i);
+    });
+    producer.join();
+    long long sum = 0;
+    for(int i = 0; i < 1000; i++) sum += s.pop();
+    assert(sum == 999LL * 1000 / 2);
+
+    /* Reusing the same nodes must not go back to the system */
+    treiber_stack<int, immediate_reclaim, packed_ptr, pool_alloc> r;
+    for(int i = 0; i < 10; i++) r.push(i);
+    for(int i = 0; i < 10; i++) r.pop();
+    stats_snapshot before = collect_stats();
+    for(int round = 0; round < 1000; round++) {
+        for(int i = 0; i < 10; i++) r.push(i);
+        for(int i = 9; i >= 0; i--) assert(r.pop() == i);
+    }
+    stats_snapshot after = collect_stats();
+    assert(after.v[STAT_SYS_ALLOCS] == before.v[STAT_SYS_ALLOCS]);
+
+    /* A thread-local torn down after the thread's cache still allocates */
+    struct late_user {
+        treiber_stack<int, immediate_reclaim, packed_ptr, pool_alloc>* st;
+        ~late_user() { st->push(7); assert(st->pop() == 7); }
+    };
+    thread exiting([&]() {
+        static thread_local late_user u{&r};
+        r.push(1);
+        assert(r.pop() == 1);
+    });
+    exiting.join();
+    cout << "PASS" << endl;
+}
+
+/* The hot-path counters see exactly the events of a single-threaded run,
+   and read zero when compiled out */
+void test_stats() {
+    cout << "Testing Event Counters... ";
+    treiber_stack<int> s;
+    fc_queue<int> q;
+    bounded_queue<int> bq;
+    reset_stats();
+    for(int i = 0; i < 100; i++) {
+        s.push(i);
+        q.enqueue(i);
+    }
+    while(s.try_pop()) {}
+    thread consumer([&]() { (void)bq.dequeue(); });
+    this_thread::sleep_for(chrono::milliseconds(20));
+    bq.enqueue(1);
+    consumer.join();
+    stats_snapshot st = collect_stats();
+#if CONTAINER_STATS
+    assert(st.v[STAT_CAS_ATTEMPTS] == 200 && st.v[STAT_CAS_FAILS] == 0);
+    assert(st.v[STAT_FC_COMBINES] == 100 && st.v[STAT_FC_PASSES] == 100 && st.v[STAT_FC_OPS] == 100);
+    assert(st.v[STAT_CV_WAITS] >= 1 && st.v[STAT_CV_WAKEUPS] <= st.v[STAT_CV_WAITS]);
+#else
+    for(int i = 0; i < STAT_COUNT; i++) assert(st.v[i] == 0);
+#endif
+
+    /* A thread-local torn down after the thread's record still counts */
+    struct late_counter {
+        ~late_counter() { stat_add(STAT_ADAPT_SWITCHES, 5); }
+    };
+    thread exiting([]() {
+        static thread_local late_counter c;
+        stat_add(STAT_ADAPT_SWITCHES);
+    });
+    exiting.join();
+#if CONTAINER_STATS
+    assert(collect_stats().v[STAT_ADAPT_SWITCHES] == st.v[STAT_ADAPT_SWITCHES] + 6);
+#endif
+
+    /* Hardware counters are optional: closed counters simply add nothing */
+    thread_perf p;
+    p.start();
+    p.stop();
+    p.add_to_stats();
+    cout << "PASS" << endl;
+}
+
+/* Every backoff policy must keep the containers exact under contention */
+template<typename Backoff>
+static void check_backoff() {
+    typedef hazard_pointers hp;
+    treiber_stack<int, hp, plain_ptr, new_alloc, padded_layout, Backoff> s;
+    elimination_stack<int, hp, plain_ptr, new_alloc, padded_layout, Backoff> e;
+    msqueue<int, hp, plain_ptr, new_alloc, padded_layout, Backoff> q;
+    fc_stack<int, padded_layout, Backoff> fs;
+    fc_queue<int, padded_layout, Backoff> fq;
+    const int threads = 4, per_thread = 2000;
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            for(int i = 0; i < per_thread; i++) {
+                int v = t * per_thread + i;
+                s.push(v); e.push(v); q.enqueue(v); fs.push(v); fq.enqueue(v);
+            }
+        });
+    }
+    for(auto& th : ts) th.join();
+
+    long long n = 1LL * threads * per_thread, sums[5] = {0, 0, 0, 0, 0};
+    for(long long i = 0; i < n; i++) {
+        sums[0] += s.pop(); sums[1] += e.pop(); sums[2] += q.dequeue();
+        sums[3] += fs.pop(); sums[4] += fq.dequeue();
+    }
+    for(long long sum : sums) assert(sum == n * (n - 1) / 2);
+}
+
+void test_backoff() {
+    cout << "Testing Backoff Policies... ";
+    check_backoff<no_backoff>();
+    check_backoff<yield_backoff>();
+    check_backoff<exp_backoff>();
+    check_backoff<prop_backoff>();
     cout << "PASS" << endl;
 }
 
-void test_fc_queue() {
-    cout << "Testing FC Queue... ";
-    fc_queue q;
-    q.enqueue(1); q.enqueue(2); q.enqueue(3);
-    assert(q.dequeue() == 1 && q.dequeue() == 2 && q.dequeue() == 3);
-    cout << "PASS" << endl;
+/* More threads than the old MAX_THREADS slot array, each with its own record */
+void test_fc_many_threads() {
+    cout << "Testing FC Publication List... ";
+    fc_stack<int> s;
+    fc_queue<int> q;
+    const int threads = 48, per_thread = 200;
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            for(int i = 0; i < per_thread; i++) {
+                s.push(t * per_thread + i);
+                q.enqueue(t * per_thread + i);
+            }
+        });
+    }
+    for(auto& th : ts) th.join();
+
+    long long n = 1LL * threads * per_thread, stack_sum = 0, queue_sum = 0;
+    for(long long i = 0; i < n; i++) {
+        stack_sum += s.pop();
+        queue_sum += q.dequeue();
+    }
+    assert(stack_sum == n * (n - 1) / 2 && queue_sum == n * (n - 1) / 2);
+    cout << "PASS" << endl;
+}
+
+/* Node combiners sharing one structure: mixed pushes and pops from
+   threads spread over the nodes must neither lose nor invent values, and
+   each producer's items must still leave the queue in order */
+template<typename Topology>
+static void check_fc_nodes() {
+    fc_stack<int, padded_layout, exp_backoff, Topology> s;
+    fc_queue<int, padded_layout, exp_backoff, Topology> q;
+    assert(s.nodes() == Topology::nodes() && q.nodes() == Topology::nodes());
+    const int threads = 6, per_thread = 5000;
+    atomic<long long> stack_sum(0), queue_sum(0);
+    atomic<int> stack_got(0), queue_got(0);
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            vector<int> last(threads, -1);
+            int v;
+            for(int i = 0; i < per_thread; i++) {
+                s.push(t * per_thread + i);
+                q.enqueue(t * per_thread + i);
+                if(s.try_pop(v)) {
+                    stack_sum += v;
+                    stack_got++;
+                }
+                if(q.try_dequeue(v)) {
+                    assert(v % per_thread > last[v / per_thread]);
+                    last[v / per_thread] = v % per_thread;
+                    queue_sum += v;
+                    queue_got++;
+                }
+            }
+        });
+    }
+    for(auto& th : ts) th.join();
+    while(optional<int> v = s.try_pop()) { stack_sum += *v; stack_got++; }
+    while(optional<int> v = q.try_dequeue()) { queue_sum += *v; queue_got++; }
+    long long n = 1LL * threads * per_thread;
+    assert(stack_got == n && stack_sum == n * (n - 1) / 2);
+    assert(queue_got == n && queue_sum == n * (n - 1) / 2);
+}
+
+void test_fc_nodes() {
+    cout << "Testing Hierarchical FC... ";
+    check_fc_nodes<sim_topology<2>>();
+    check_fc_nodes<sim_topology<3>>();
+    check_fc_nodes<numa_topology>();
+    check_move_only_stack<fc_stack<tracked, padded_layout, exp_backoff, sim_topology<2>>>();
+    check_move_only_queue<fc_queue<tracked, padded_layout, exp_backoff, sim_topology<2>>>();
+    check_stack_bulk<fc_stack<int, padded_layout, exp_backoff, sim_topology<2>>>();
+    check_queue_bulk<fc_queue<int, padded_layout, exp_backoff, sim_topology<2>>>();
+
+    /* The node count can also be chosen per container */
+    fc_stack<int> s(4);
+    s.push(1); s.push(2);
+    assert(s.nodes() == 4 && s.pop() == 2 && s.pop() == 1);
+    bool threw = false;
+    try { fc_queue<int> q(0); } catch(const invalid_argument&) { threw = true; }
+    assert(threw);
+    cout << "PASS" << endl;
+}
+
+/* Any sequential object behind the combining primitive: every request
+   runs exactly once and alone, across more threads than one combiner run
+   serves, and an exception reaches the thread that made the request */
+template<typename Topology>
+static void check_cc_synch() {
+    struct counter {
+        long long sum = 0;
+        int inside = 0;
+    };
+    cc_synch<counter, padded_layout, exp_backoff, Topology> c;
+    const int threads = 2 * CC_RUN, per_thread = 200;
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            for(int i = 0; i < per_thread; i++) {
+                c.execute([&](counter& x) {
+                    assert(x.inside++ == 0);
+                    x.sum += t * per_thread + i;
+                    x.inside--;
+                });
+            }
+        });
+    }
+    for(auto& th : ts) th.join();
+    long long n = 1LL * threads * per_thread, sum = 0;
+    c.execute([&](counter& x) { sum = x.sum; });
+    assert(sum == n * (n - 1) / 2);
+
+    bool threw = false;
+    try {
+        c.execute([](counter&) { throw runtime_error("inside"); });
+    } catch(const runtime_error&) { threw = true; }
+    c.execute([&](counter& x) { sum = x.sum; });
+    assert(threw && sum == n * (n - 1) / 2);
+}
+
+void test_cc_synch() {
+    cout << "Testing CC-Synch Combining... ";
+    check_cc_synch<flat_topology>();
+    check_cc_synch<sim_topology<2>>();
+    bool threw = false;
+    try { cc_synch<int> c(0); } catch(const invalid_argument&) { threw = true; }
+    assert(threw);
+    cout << "PASS" << endl;
+}
+
+/* Several producers and consumers through a small buffer, so both sides
+   really sleep; every item must arrive exactly once */
+template<typename Queue>
+static void check_blocking_queue(int max_spin) {
+    Queue bq(BQ_CAPACITY, max_spin);
+    const int threads = 3, per_thread = 2000;
+    atomic<long long> sum(0);
+    vector<thread> ts;
+    for(int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t]() {
+            for(int i = 0; i < per_thread; i++) bq.enqueue(t * per_thread + i);
+        });
+        ts.emplace_back([&]() {
+            for(int i = 0; i < per_thread; i++) sum += bq.dequeue();
+        });
+    }
+    for(auto& th : ts) th.join();
+    long long n = 1LL * threads * per_thread;
+    assert(sum == n * (n - 1) / 2 && !bq.try_dequeue());
+}
+
+/* Runtime capacity, wraparound of the masked indices, and bulk runs
+   longer than the capacity going through in several lock acquisitions */
+template<typename Queue>
+static void check_bounded_bulk() {
+    bool threw = false;
+    try { Queue bad(48); } catch(const invalid_argument&) { threw = true; }
+    assert(threw);
+
+    Queue q(8);
+    int in[100], out[100];
+    for(int i = 0; i < 100; i++) in[i] = i;
+    assert(q.capacity() == 8);
+    q.enqueue_bulk(in, 5);
+    assert(q.dequeue_bulk(out, 3) == 3 && out[0] == 0 && out[2] == 2);
+    q.enqueue_bulk(in + 5, 6);
+    assert(q.dequeue_bulk(out, 100) == 8 && out[0] == 3 && out[7] == 10);
+    assert(q.dequeue_bulk(out, 1) == 0);
+
+    const int producers = 3, per_thread = 2002, batch = 13;
+    vector<thread> ts;
+    for(int t = 0; t < producers; t++) {
+        ts.emplace_back([&, t]() {
+            vector<int> v(batch);
+            for(int i = 0; i < per_thread; i += batch) {
+                for(int j = 0; j < batch; j++) v[j] = t * per_thread + i + j;
+                q.enqueue_bulk(v.data(), batch);
+            }
+        });
+    }
+    long long sum = 0, n = 1LL * producers * per_thread;
+    for(long long got = 0; got < n;) {
+        size_t k = q.dequeue_bulk_wait(out, 100);
+        for(size_t i = 0; i < k; i++) sum += out[i];
+        got += k;
+    }
+    for(auto& th : ts) th.join();
+    assert(sum == n * (n - 1) / 2 && !q.try_dequeue());
+}
+
+void test_condvar() {
+    cout << "Testing Condition Variable... ";
+    bounded_queue<int> bq;
+    
+    thread producer([&]() {
+        for(int i = 0; i < 50; i++) bq.enqueue(i);
+    });
+    
+    thread consumer([&]() {
+        for(int i = 0; i < 50; i++) bq.dequeue();
+    });
+    
+    producer.join();
+    consumer.join();
+
+    check_blocking_queue<bounded_queue<int>>(CV_SPIN_MAX);
+    check_blocking_queue<bounded_queue<int>>(0);
+#ifdef HAVE_FUTEX
+    check_blocking_queue<bounded_queue<int, condvar_futex>>(CV_SPIN_MAX);
+    check_blocking_queue<bounded_queue<int, condvar_futex>>(0);
+#endif
+    check_bounded_bulk<bounded_queue<int>>();
+#ifdef HAVE_FUTEX
+    check_bounded_bulk<bounded_queue<int, condvar_futex>>();
+#endif
+    cout << "PASS" << endl;
+}
+
+/* High contention test - all threads start simultaneously */
+void test_contention() {
+    cout << "\n=== Contention Test (8 threads) ===" << endl;
+    
+    treiber_stack<int> s;
+    atomic<bool> go(false);
+    atomic<int> ready(0);
+    
+    auto worker = [&]() {
+        ready++;
+        while(!go.load()) { } // Wait for signal
+        
+        int v;
+        for(int i = 0; i < 5000; i++) {
+            s.push(i);
+            (void)s.try_pop(v);
+        }
+    };
+    
+    vector<thread> ts;
+    for(int t = 0; t < 8; t++)
+        ts.emplace_back(worker);
+    
+    while(ready.load() < 8) { }
+    
+    auto start = chrono::high_resolution_clock::now();
+    go.store(true); // Release all threads at once
+    
+    for(auto& t : ts) t.join();
+    auto end = chrono::high_resolution_clock::now();
+    
+    double ms = chrono::duration<double, milli>(end - start).count();
+    cout << "Time: " << ms << " ms (all threads competed simultaneously)" << endl;
+}
+
+/* Counters gathered since the last reset_stats(), hardware counters per
+   op when the row knows its op count */
+static void print_stats(long long ops = 0) {
+#if !CONTAINER_STATS
+    (void)ops;
+    cout << "  stats=off";
+#else
+    stats_snapshot st = collect_stats();
+    cout << "  allocs=" << st.v[STAT_ALLOCS]
+         << "  sys_allocs=" << st.v[STAT_SYS_ALLOCS]
+         << "  sys_bytes=" << st.v[STAT_SYS_BYTES];
+    if(st.v[STAT_CAS_ATTEMPTS])
+        cout << "  cas_fail=" << 100.0 * st.v[STAT_CAS_FAILS] / st.v[STAT_CAS_ATTEMPTS] << "%"
+             << " (" << st.v[STAT_CAS_FAILS] << "/" << st.v[STAT_CAS_ATTEMPTS] << ")";
+    if(st.v[STAT_ELIM_ATTEMPTS])
+        cout << "  elim_hit=" << 100.0 * st.v[STAT_ELIM_HITS] / st.v[STAT_ELIM_ATTEMPTS] << "%"
+             << " (" << st.v[STAT_ELIM_HITS] << "/" << st.v[STAT_ELIM_ATTEMPTS] << ")";
+    if(st.v[STAT_FC_COMBINES])
+        cout << "  ops/combine=" << (double)st.v[STAT_FC_OPS] / st.v[STAT_FC_COMBINES]
+             << "  passes/combine=" << (double)st.v[STAT_FC_PASSES] / st.v[STAT_FC_COMBINES]
+             << "  paired=" << (st.v[STAT_FC_OPS] ? 100.0 * st.v[STAT_FC_PAIRED] / st.v[STAT_FC_OPS] : 0.0) << "%";
+    if(st.v[STAT_FC_SHARED])
+        cout << "  ops/shared_lock=" << (double)st.v[STAT_FC_OPS] / st.v[STAT_FC_SHARED];
+    if(st.v[STAT_ADAPT_SWITCHES])
+        cout << "  switches=" << st.v[STAT_ADAPT_SWITCHES];
+    if(st.v[STAT_CV_WAITS])
+        cout << "  cv_waits=" << st.v[STAT_CV_WAITS]
+             << "  cv_sleeps=" << st.v[STAT_CV_SLEEPS]
+             << "  cv_wakeups=" << st.v[STAT_CV_WAKEUPS];
+    if(ops > 0 && st.v[STAT_PERF_CYCLES])
+        cout << "  cycles/op=" << (double)st.v[STAT_PERF_CYCLES] / ops
+             << "  insns/op=" << (double)st.v[STAT_PERF_INSNS] / ops
+             << "  misses/op=" << (double)st.v[STAT_PERF_CACHE_MISSES] / ops;
+#endif
+}
+
+/* Benchmark payloads, built from the int the workers would push */
+template<typename T> struct payload;
+
+template<> struct payload<int> {
+    static constexpr const char* name = "int";
+    static int make(int v) { return v; }
+};
+
+template<> struct payload<pod64> {
+    static constexpr const char* name = "pod64";
+    static pod64 make(int v) {
+        pod64 p = {};
+        p.v = v;
+        return p;
+    }
+};
+
+template<> struct payload<unique_ptr<pod64>> {
+    static constexpr const char* name = "unique_ptr";
+    static unique_ptr<pod64> make(int v) {
+        unique_ptr<pod64> p(new pod64());
+        p->v = v;
+        return p;
+    }
+};
+
+/* Nanoseconds on the steady clock, the payload of the latency benchmark */
+static long long now_ns() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Placement of benchmark threads and hardware counters, -pin and -perf
+   on the command line */
+static pin_policy bench_pin = PIN_COMPACT;
+static bool bench_perf = false;
+
+/* Run body(id) on threads ids 0..threads-1, each pinned by pin. Every
+   thread first runs warm(id), then waits at a start barrier; the clock
+   starts when the last one arrives, so thread creation, page faults and
+   cold caches stay out of the measurement. The main thread runs
+   started() once the clock is going. With perf, every thread counts its
+   own timed phase into its stats. Returns the seconds from the start to
+   the last thread finishing. */
+template<typename Warm, typename Body, typename Started>
+static double run_pinned(int threads, pin_policy pin, bool perf, Warm warm, Body body, Started started) {
+    const vector<int>& cpus = pin_order(pin);
+    atomic<int> ready(0);
+    atomic<bool> go(false);
+    vector<long long> finish(threads);
+    vector<thread> ts;
+    for(int t = 0; t < threads; ++t) {
+        ts.emplace_back([&, t]() {
+            if(!cpus.empty()) pin_thread(cpus[t % cpus.size()]);
+            warm(t);
+            optional<thread_perf> counters;
+            if(perf) counters.emplace();
+            ready++;
+            while(!go.load()) this_thread::yield();
+            if(counters) counters->start();
+            body(t);
+            finish[t] = now_ns();
+            if(counters) {
+                counters->stop();
+                counters->add_to_stats();
+            }
+        });
+    }
+    while(ready.load() < threads) this_thread::yield();
+    reset_stats();
+    long long start = now_ns();
+    go.store(true);
+    started();
+    for(auto& th : ts)
+        th.join();
+    return (*max_element(finish.begin(), finish.end()) - start) / 1e9;
+}
+
+template<typename Warm, typename Body>
+static double run_pinned(int threads, pin_policy pin, bool perf, Warm warm, Body body) {
+    return run_pinned(threads, pin, perf, warm, body, [] {});
+}
+
+/* Benchmark a stack with multiple thread counts */
+template<typename Stack>
+static void bench_stack(const string& name, int threads, int ops_per_thread, int batch = 1) {
+    typedef typename Stack::value_type T;
+    Stack s;
+
+    for(int i = 0; i < threads * ops_per_thread; ++i)
+        s.push(payload<T>::make(i));
+
+    /* batch > 1: alternate push_n / pop_n of batch items, ops count items
+       (bulk pushes copy, so only for copyable payloads) */
+    auto worker = [&](int id, int ops) {
+        if constexpr(is_copy_constructible<T>::value) {
+            if(batch > 1) {
+                vector<T> buf(batch);
+                for(int i = 0; i < ops; i += batch) {
+                    if(((i / batch) & 1) == 0) {
+                        for(int k = 0; k < batch; ++k) buf[k] = payload<T>::make(id * ops_per_thread + i + k);
+                        s.push_n(buf.data(), batch);
+                    } else {
+                        (void)s.pop_n(buf.data(), batch);
+                    }
+                }
+                return;
+            }
+        }
+        T v;
+        for(int i = 0; i < ops; ++i) {
+            if((i & 1) == 0)
+                s.push(payload<T>::make(id * ops_per_thread + i));
+            else
+                (void)s.try_pop(v);
+        }
+    };
+
+    double secs = run_pinned(threads, bench_pin, bench_perf,
+                             [&](int id) { worker(id, ops_per_thread / 10); },
+                             [&](int id) { worker(id, ops_per_thread); });
+    long long total_ops = 1LL * threads * ops_per_thread;
+    double throughput = total_ops / secs;
+
+    cout << "  " << name << "  threads=" << threads;
+    if(batch > 1) cout << "  batch=" << batch;
+    cout << "  ops=" << total_ops
+              << "  throughput=" << throughput << " ops/s";
+    print_stats(total_ops);
+    cout << "\n";
+}
+
+/* Producer and consumer thread counts of a queue benchmark */
+struct pc_ratio {
+    int producers, consumers;
+
+    /* Default split: half the threads produce, the rest consume */
+    static pc_ratio of(int threads) {
+        int p = threads / 2 > 0 ? threads / 2 : 1;
+        int c = threads - p > 0 ? threads - p : 1;
+        return {p, c};
+    }
+};
+
+/* Benchmark a queue with producer/consumer threads */
+template<typename Queue>
+static void bench_queue(const string& name, pc_ratio r, int ops_per_thread, int batch = 1) {
+    typedef typename Queue::value_type T;
+    Queue q;
+
+    auto producer = [&](int id, int ops) {
+        if constexpr(is_copy_constructible<T>::value) {
+            if(batch > 1) {
+                vector<T> buf(batch);
+                for(int i = 0; i < ops; i += batch) {
+                    for(int k = 0; k < batch; ++k) buf[k] = payload<T>::make(id * ops_per_thread + i + k);
+                    q.enqueue_bulk(buf.data(), batch);
+                }
+                return;
+            }
+        }
+        for(int i = 0; i < ops; ++i)
+            q.enqueue(payload<T>::make(id * ops_per_thread + i));
+    };
+
+    auto consumer = [&](int ops) {
+        if(batch > 1) {
+            vector<T> buf(batch);
+            for(int i = 0; i < ops; i += batch)
+                (void)q.dequeue_bulk(buf.data(), batch);
+            return;
+        }
+        T v;
+        for(int i = 0; i < ops; ++i)
+            (void)q.try_dequeue(v);
+    };
+
+    int prod_threads = r.producers;
+    int cons_threads = r.consumers;
+
+    /* Threads 0..producers-1 produce, the rest consume */
+    auto role = [&](int id, int ops) {
+        if(id < prod_threads) producer(id, ops);
+        else consumer(ops);
+    };
+    double secs = run_pinned(prod_threads + cons_threads, bench_pin, bench_perf,
+                             [&](int id) { role(id, ops_per_thread / 10); },
+                             [&](int id) { role(id, ops_per_thread); });
+    long long total_ops = 1LL * ops_per_thread * (prod_threads + cons_threads);
+    double throughput = total_ops / secs;
+
+    cout << "  " << name << "  threads=" << prod_threads + cons_threads
+         << " (" << prod_threads << ":" << cons_threads << ")";
+    if(batch > 1) cout << "  batch=" << batch;
+    cout << "  ops=" << total_ops
+              << "  throughput=" << throughput << " ops/s";
+    print_stats(total_ops);
+    cout << "\n";
+}
+
+template<typename Queue>
+static void bench_queue(const string& name, int threads, int ops_per_thread, int batch = 1) {
+    bench_queue<Queue>(name, pc_ratio::of(threads), ops_per_thread, batch);
+}
+
+/* Producer/consumer handoff where every item is consumed: consumers
+   retry until they get one, so bounded queues whose producers block can
+   be compared with unbounded ones. Extra args go to the constructor. */
+template<typename Queue, typename... Args>
+static void bench_pipeline(const string& name, pc_ratio r, int ops_per_thread, Args... args) {
+    typedef typename Queue::value_type T;
+    Queue q(args...);
+
+    int prod_threads = r.producers;
+    int cons_threads = r.consumers;
+    atomic<long long> remaining(1LL * prod_threads * ops_per_thread);
+
+    auto producer = [&](int id) {
+        for(int i = 0; i < ops_per_thread; ++i)
+            q.enqueue(payload<T>::make(id * ops_per_thread + i));
+    };
+
+    auto consumer = [&]() {
+        T v;
+        while(remaining.fetch_sub(1) > 0) {
+            while(!q.try_dequeue(v))
+                this_thread::yield();
+        }
+    };
+
+    /* No warmup: every item must be consumed exactly once */
+    double secs = run_pinned(prod_threads + cons_threads, bench_pin, bench_perf, [](int) {}, [&](int id) {
+        if(id < prod_threads) producer(id);
+        else consumer();
+    });
+    long long items = 1LL * prod_threads * ops_per_thread;
+
+    cout << "  " << name << "  threads=" << prod_threads + cons_threads
+         << " (" << prod_threads << ":" << cons_threads << ")"
+         << "  items=" << items
+         << "  throughput=" << items / secs << " items/s";
+    print_stats(items);
+    cout << "\n";
+}
+
+/* Blocking producer/consumer handoff: consumers call the blocking
+   dequeue, items carry their enqueue time, and the row reports the
+   enqueue-to-dequeue latency. gap_ns > 0 paces every producer so the
+   consumers keep going to sleep, which is where wakeup cost shows. */
+template<typename Queue>
+static void bench_blocking(const string& name, pc_ratio r, int items_per_producer,
+                           long long gap_ns, int max_spin) {
+    Queue q(BQ_CAPACITY, max_spin);
+    atomic<long long> remaining(1LL * r.producers * items_per_producer);
+    vector<vector<long long>> lat(r.consumers);
+
+    auto producer = [&]() {
+        long long next = now_ns();
+        for(int i = 0; i < items_per_producer; ++i) {
+            if(gap_ns > 0) {
+                next += gap_ns;
+                while(now_ns() < next) this_thread::yield();
+            }
+            q.enqueue(now_ns());
+        }
+    };
+
+    auto consumer = [&](int id) {
+        while(remaining.fetch_sub(1) > 0) {
+            long long sent = q.dequeue();
+            lat[id].push_back(now_ns() - sent);
+        }
+    };
+
+    vector<thread> ts;
+    reset_stats();
+    auto start = chrono::high_resolution_clock::now();
+    for(int t = 0; t < r.producers; ++t)
+        ts.emplace_back(producer);
+    for(int t = 0; t < r.consumers; ++t)
+        ts.emplace_back(consumer, t);
+    for(auto& th : ts)
+        th.join();
+    auto end = chrono::high_resolution_clock::now();
+
+    vector<long long> all;
+    for(auto& v : lat) all.insert(all.end(), v.begin(), v.end());
+    sort(all.begin(), all.end());
+    double secs = chrono::duration<double>(end - start).count();
+
+    cout << "  " << name << "  threads=" << r.producers + r.consumers
+         << " (" << r.producers << ":" << r.consumers << ")"
+         << "  gap=" << gap_ns << "ns"
+         << "  throughput=" << all.size() / secs << " items/s"
+         << "  p50=" << all[all.size() / 2] / 1000.0 << "us"
+         << "  p99=" << all[all.size() * 99 / 100] / 1000.0 << "us";
+    print_stats();
+    cout << "\n";
+}
+
+/* CPU time of the calling thread, user + system, in seconds */
+static double thread_cpu_secs() {
+    struct rusage ru;
+    getrusage(RUSAGE_THREAD, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec
+         + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+/* Paced producers, consumers either busy-poll try_dequeue() or sleep in
+   dequeue_wait(); the row reports handoff latency and the share of the
+   run each consumer spent on a CPU */
+template<typename Queue>
+static void bench_wait_handoff(const string& name, pc_ratio r, int items_per_producer,
+                       long long gap_ns, bool park) {
+    Queue q;
+    atomic<long long> remaining(1LL * r.producers * items_per_producer);
+    vector<vector<long long>> lat(r.consumers);
+    vector<double> cpu(r.consumers);
+
+    auto producer = [&]() {
+        long long next = now_ns();
+        for(int i = 0; i < items_per_producer; ++i) {
+            next += gap_ns;
+            while(now_ns() < next) this_thread::yield();
+            q.enqueue(now_ns());
+        }
+    };
+
+    auto consumer = [&](int id) {
+        while(remaining.fetch_sub(1) > 0) {
+            long long sent;
+            if(park) sent = q.dequeue_wait();
+            else while(!q.try_dequeue(sent)) {}
+            lat[id].push_back(now_ns() - sent);
+        }
+        cpu[id] = thread_cpu_secs();
+    };
+
+    vector<thread> ts;
+    auto start = chrono::high_resolution_clock::now();
+    for(int t = 0; t < r.producers; ++t)
+        ts.emplace_back(producer);
+    for(int t = 0; t < r.consumers; ++t)
+        ts.emplace_back(consumer, t);
+    for(auto& th : ts)
+        th.join();
+    auto end = chrono::high_resolution_clock::now();
+
+    vector<long long> all;
+    for(auto& v : lat) all.insert(all.end(), v.begin(), v.end());
+    sort(all.begin(), all.end());
+    double secs = chrono::duration<double>(end - start).count();
+
+    cout << "  " << name << "  threads=" << r.producers + r.consumers
+         << " (" << r.producers << ":" << r.consumers << ")"
+         << "  gap=" << gap_ns << "ns"
+         << "  p50=" << all[all.size() / 2] / 1000.0 << "us"
+         << "  p99=" << all[all.size() * 99 / 100] / 1000.0 << "us"
+         << "  consumer_cpu=" << 100.0 * accumulate(cpu.begin(), cpu.end(), 0.0) / (secs * r.consumers) << "%\n";
+}
+
+/* Busy-polling consumers against spin-then-park blocking dequeues */
+static void bench_wait() {
+    const int items = 2000;
+    pc_ratio ratios[] = {{1, 1}, {1, 4}};
+    long long gaps[] = {20000, 200000};
+
+    cout << "=== Blocking Dequeue Benchmarks ===\n";
+    for(pc_ratio r : ratios) {
+        for(long long gap : gaps) {
+            bench_wait_handoff<msqueue<long long>>("M&S   poll", r, items, gap, false);
+            bench_wait_handoff<msqueue<long long>>("M&S   wait", r, items, gap, true);
+            bench_wait_handoff<faa_queue<long long>>("FAA   poll", r, items, gap, false);
+            bench_wait_handoff<faa_queue<long long>>("FAA   wait", r, items, gap, true);
+        }
+    }
+}
+
+/* Resident set size of this process in MB */
+static double rss_mb() {
+    ifstream statm("/proc/self/statm");
+    long pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * (double)sysconf(_SC_PAGESIZE) / (1024 * 1024);
+}
+
+/* Throughput and steady-state RSS of one reclamation policy */
+template<typename Reclaim>
+static void bench_reclaim_policy(const int* thread_counts, int n, int ops_per_thread) {
+    cout << "--- policy=" << Reclaim::name << " ---\n";
+    for(int round = 0; round < 3; round++) {
+        for(int i = 0; i < n; i++) {
+            bench_stack<treiber_stack<int, Reclaim>>("Treiber Stack  ", thread_counts[i], ops_per_thread);
+            bench_queue<msqueue<int, Reclaim>>("M&S Queue      ", thread_counts[i], ops_per_thread);
+        }
+        cout << "  round " << round << "  RSS=" << rss_mb() << " MB\n";
+    }
+}
+
+/* Compare reclamation policies; leak runs last since it only grows */
+static void bench_reclaim() {
+    const int ops_per_thread = 200000;
+    int thread_counts[] = {1, 4, 16};
+
+    cout << "=== Reclamation Benchmarks ===\n";
+    bench_reclaim_policy<hazard_pointers>(thread_counts, 3, ops_per_thread);
+    bench_reclaim_policy<epoch_based>(thread_counts, 3, ops_per_thread);
+    bench_reclaim_policy<no_reclaim>(thread_counts, 3, ops_per_thread);
+}
+
+/* CAS width cost: plain vs packed vs 16-byte tags, then tags with reuse */
+static void bench_tagged() {
+    const int ops_per_thread = 100000;
+    int thread_counts[] = {1, 2, 4, 8, 16};
+
+    cout << "=== Tagged Pointer Benchmarks ===\n";
+    for(int t : thread_counts) {
+        bench_stack<treiber_stack<int>>("Treiber hazard/plain      ", t, ops_per_thread);
+        bench_stack<treiber_stack<int, hazard_pointers, packed_ptr>>("Treiber hazard/packed     ", t, ops_per_thread);
+#ifdef HAVE_DWCAS
+        bench_stack<treiber_stack<int, hazard_pointers, dwcas_ptr>>("Treiber hazard/dwcas      ", t, ops_per_thread);
+#endif
+        bench_stack<treiber_stack<int, immediate_reclaim, packed_ptr, freelist_alloc>>("Treiber reuse/packed      ", t, ops_per_thread);
+#ifdef HAVE_DWCAS
+        bench_stack<treiber_stack<int, immediate_reclaim, dwcas_ptr, freelist_alloc>>("Treiber reuse/dwcas       ", t, ops_per_thread);
+#endif
+    }
+    for(int t : thread_counts) {
+        bench_queue<msqueue<int>>("M&S hazard/plain          ", t, ops_per_thread);
+        bench_queue<msqueue<int, hazard_pointers, packed_ptr>>("M&S hazard/packed         ", t, ops_per_thread);
+#ifdef HAVE_DWCAS
+        bench_queue<msqueue<int, hazard_pointers, dwcas_ptr>>("M&S hazard/dwcas          ", t, ops_per_thread);
+#endif
+        bench_queue<msqueue<int, immediate_reclaim, packed_ptr, freelist_alloc>>("M&S reuse/packed          ", t, ops_per_thread);
+#ifdef HAVE_DWCAS
+        bench_queue<msqueue<int, immediate_reclaim, dwcas_ptr, freelist_alloc>>("M&S reuse/dwcas           ", t, ops_per_thread);
+#endif
+    }
+}
+
+/* Node allocator comparison on the push/enqueue hot paths */
+static void bench_alloc() {
+    const int ops_per_thread = 100000;
+    int thread_counts[] = {1, 2, 4, 8, 16};
+
+    cout << "=== Allocator Benchmarks ===\n";
+    for(int t : thread_counts) {
+        bench_stack<treiber_stack<int>>("Treiber hazard/new        ", t, ops_per_thread);
+        bench_stack<treiber_stack<int, hazard_pointers, plain_ptr, pool_alloc>>("Treiber hazard/pool       ", t, ops_per_thread);
+        bench_stack<treiber_stack<int, immediate_reclaim, packed_ptr, freelist_alloc>>("Treiber reuse/freelist    ", t, ops_per_thread);
+        bench_stack<treiber_stack<int, immediate_reclaim, packed_ptr, pool_alloc>>("Treiber reuse/pool        ", t, ops_per_thread);
+        bench_stack<elimination_stack<int>>("Elimination hazard/new    ", t, ops_per_thread);
+        bench_stack<elimination_stack<int, hazard_pointers, plain_ptr, pool_alloc>>("Elimination hazard/pool   ", t, ops_per_thread);
+    }
+    for(int t : thread_counts) {
+        bench_queue<msqueue<int>>("M&S hazard/new            ", t, ops_per_thread);
+        bench_queue<msqueue<int, hazard_pointers, plain_ptr, pool_alloc>>("M&S hazard/pool           ", t, ops_per_thread);
+        bench_queue<msqueue<int, immediate_reclaim, packed_ptr, freelist_alloc>>("M&S reuse/freelist        ", t, ops_per_thread);
+        bench_queue<msqueue<int, immediate_reclaim, packed_ptr, pool_alloc>>("M&S reuse/pool            ", t, ops_per_thread);
+    }
+}
+
+/* Padded vs packed layout of hot words and per-thread records */
+static void bench_layout() {
+    const int ops_per_thread = 100000;
+    int thread_counts[] = {1, 2, 4, 8, 16};
+    typedef hazard_pointers hp;
+
+    cout << "=== Layout Benchmarks ===\n";
+    for(int t : thread_counts) {
+        bench_stack<treiber_stack<int, hp, plain_ptr, new_alloc, padded_layout>>("Treiber padded     ", t, ops_per_thread);
+        bench_stack<treiber_stack<int, hp, plain_ptr, new_alloc, packed_layout>>("Treiber packed     ", t, ops_per_thread);
+        bench_stack<elimination_stack<int, hp, plain_ptr, new_alloc, padded_layout>>("Elimination padded ", t, ops_per_thread);
+        bench_stack<elimination_stack<int, hp, plain_ptr, new_alloc, packed_layout>>("Elimination packed ", t, ops_per_thread);
+        bench_stack<fc_stack<int, padded_layout>>("FC Stack padded    ", t, ops_per_thread);
+        bench_stack<fc_stack<int, packed_layout>>("FC Stack packed    ", t, ops_per_thread);
+    }
+    for(int t : thread_counts) {
+        bench_queue<msqueue<int, hp, plain_ptr, new_alloc, padded_layout>>("M&S padded         ", t, ops_per_thread);
+        bench_queue<msqueue<int, hp, plain_ptr, new_alloc, packed_layout>>("M&S packed         ", t, ops_per_thread);
+        bench_queue<fc_queue<int, padded_layout>>("FC Queue padded    ", t, ops_per_thread);
+        bench_queue<fc_queue<int, packed_layout>>("FC Queue packed    ", t, ops_per_thread);
+    }
+}
+
+/* Every container under one backoff policy */
+template<typename Backoff>
+static void bench_backoff_policy(int threads, int ops_per_thread) {
+    typedef hazard_pointers hp;
+    string tag = string(" ") + Backoff::name;
+    tag.resize(14, ' ');
+    bench_stack<treiber_stack<int, hp, plain_ptr, new_alloc, padded_layout, Backoff>>("Treiber    " + tag, threads, ops_per_thread);
+    bench_stack<elimination_stack<int, hp, plain_ptr, new_alloc, padded_layout, Backoff>>("Elimination" + tag, threads, ops_per_thread);
+    bench_stack<fc_stack<int, padded_layout, Backoff>>("FC Stack   " + tag, threads, ops_per_thread);
+    bench_queue<msqueue<int, hp, plain_ptr, new_alloc, padded_layout, Backoff>>("M&S Queue  " + tag, threads, ops_per_thread);
+    bench_queue<fc_queue<int, padded_layout, Backoff>>("FC Queue   " + tag, threads, ops_per_thread);
+}
+
+/* CAS retry and combiner wait backoff policies */
+static void bench_backoff() {
+    const int ops_per_thread = 100000;
+    int thread_counts[] = {1, 4, 16};
+
+    cout << "=== Backoff Benchmarks ===\n";
+    for(int t : thread_counts) {
+        bench_backoff_policy<no_backoff>(t, ops_per_thread);
+        bench_backoff_policy<yield_backoff>(t, ops_per_thread);
+        bench_backoff_policy<exp_backoff>(t, ops_per_thread);
+        bench_backoff_policy<prop_backoff>(t, ops_per_thread);
+    }
+}
+
+/* Both FC containers with their combiners split over Topology's nodes */
+template<typename Topology>
+static void bench_numa_nodes(int threads, int ops_per_thread) {
+    string tag = string(" nodes=") + to_string(Topology::nodes()) + " " + Topology::name;
+    tag.resize(14, ' ');
+    bench_stack<fc_stack<int, padded_layout, exp_backoff, Topology>>("FC Stack" + tag, threads, ops_per_thread);
+    bench_queue<fc_queue<int, padded_layout, exp_backoff, Topology>>("FC Queue" + tag, threads, ops_per_thread);
+}
+
+/* Flat vs hierarchical combining, split by node count. Simulated nodes
+   deal threads round robin; the numa rows use the host's real sockets. */
+static void bench_numa() {
+    const int ops_per_thread = 100000;
+    int thread_counts[] = {4, 16};
+
+    cout << "=== NUMA Combining Benchmarks (host nodes=" << numa_topology::nodes() << ") ===\n";
+    for(int t : thread_counts) {
+        bench_numa_nodes<flat_topology>(t, ops_per_thread);
+        bench_numa_nodes<sim_topology<2>>(t, ops_per_thread);
+        bench_numa_nodes<sim_topology<4>>(t, ops_per_thread);
+        bench_numa_nodes<numa_topology>(t, ops_per_thread);
+    }
+}
+
+/* Single-item vs bulk APIs across batch sizes */
+static void bench_batch() {
+    const int ops_per_thread = 102400;
+    int thread_counts[] = {1, 4, 16};
+    int batches[] = {1, 16, 64, 256};
+
+    cout << "=== Batch Benchmarks ===\n";
+    for(int t : thread_counts) {
+        for(int b : batches) {
+            bench_stack<sgl_stack<int>>("SGL Stack      ", t, ops_per_thread, b);
+            bench_stack<treiber_stack<int>>("Treiber Stack  ", t, ops_per_thread, b);
+            bench_stack<elimination_stack<int>>("Elimination Stk", t, ops_per_thread, b);
+            bench_stack<fc_stack<int>>("FC Stack       ", t, ops_per_thread, b);
+        }
+    }
+    for(int t : thread_counts) {
+        for(int b : batches) {
+            bench_queue<sgl_queue<int>>("SGL Queue      ", t, ops_per_thread, b);
+            bench_queue<msqueue<int>>("M&S Queue      ", t, ops_per_thread, b);
+            bench_queue<fc_queue<int>>("FC Queue       ", t, ops_per_thread, b);
+        }
+    }
 }
 
-void test_condvar() {
-    cout << "Testing Condition Variable... ";
-    bounded_queue bq;
-    
-    thread producer([&]() {
-        for(int i = 0; i < 50; i++) bq.enqueue(i);
-    });
-    
-    thread consumer([&]() {
-        for(int i = 0; i < 50; i++) bq.dequeue();
-    });
-    
-    producer.join();
-    consumer.join();
-    cout << "PASS" << endl;
+/* One payload type through every stack and queue */
+template<typename T>
+static void bench_payload_type(int threads, int ops_per_thread) {
+    string p = string(" ") + payload<T>::name;
+    p.resize(12, ' ');
+    bench_stack<sgl_stack<T>>("SGL Stack      " + p, threads, ops_per_thread);
+    bench_stack<treiber_stack<T>>("Treiber Stack  " + p, threads, ops_per_thread);
+    bench_stack<elimination_stack<T>>("Elimination Stk" + p, threads, ops_per_thread);
+    bench_stack<fc_stack<T>>("FC Stack       " + p, threads, ops_per_thread);
+    bench_queue<sgl_queue<T>>("SGL Queue      " + p, threads, ops_per_thread);
+    bench_queue<msqueue<T>>("M&S Queue      " + p, threads, ops_per_thread);
+    bench_queue<fc_queue<T>>("FC Queue       " + p, threads, ops_per_thread);
 }
 
-/* High contention test - all threads start simultaneously */
-void test_contention() {
-    cout << "\n=== Contention Test (8 threads) ===" << endl;
-    
-    treiber_stack s;
-    atomic<bool> go(false);
-    atomic<int> ready(0);
-    
-    auto worker = [&]() {
-        ready++;
-        while(!go.load()) { } // Wait for signal
-        
-        for(int i = 0; i < 5000; i++) {
-            s.push(i);
-            try { s.pop(); } catch(...) {}
-        }
+/* int vs 64-byte POD vs owning pointer payloads */
+static void bench_payload() {
+    const int ops_per_thread = 100000;
+    int thread_counts[] = {1, 4, 16};
+
+    cout << "=== Payload Benchmarks ===\n";
+    for(int t : thread_counts) {
+        bench_payload_type<int>(t, ops_per_thread);
+        bench_payload_type<pod64>(t, ops_per_thread);
+        bench_payload_type<unique_ptr<pod64>>(t, ops_per_thread);
+    }
+}
+
+/* Lock-free ring against the condvar queue and the unbounded M&S queue */
+static void bench_ring() {
+    const int ops_per_thread = 100000;
+    int thread_counts[] = {2, 4, 8, 16};
+
+    cout << "=== Bounded Queue Benchmarks ===\n";
+    for(int t : thread_counts) {
+        pc_ratio r = pc_ratio::of(t);
+        bench_pipeline<bounded_queue<int>>("Bounded Queue (64)  ", r, ops_per_thread);
+        bench_pipeline<mpmc_ring<int>>("MPMC Ring (64)      ", r, ops_per_thread, 64);
+        bench_pipeline<mpmc_ring<int>>("MPMC Ring (1024)    ", r, ops_per_thread, 1024);
+        bench_pipeline<mpmc_ring<int, packed_layout>>("MPMC Ring packed    ", r, ops_per_thread, 1024);
+        bench_pipeline<msqueue<int>>("M&S Queue           ", r, ops_per_thread);
+    }
+}
+
+/* Producer:consumer ratios, with the single-producer and single-consumer
+   queues where the ratio allows them */
+static void bench_ratio() {
+    const int ops_per_thread = 100000;
+    pc_ratio ratios[] = {{1, 1}, {4, 1}, {8, 1}, {1, 4}, {1, 8}, {4, 4}};
+
+    cout << "=== Producer:Consumer Benchmarks ===\n";
+    for(pc_ratio r : ratios) {
+        bench_pipeline<sgl_queue<int>>("SGL Queue      ", r, ops_per_thread);
+        bench_pipeline<msqueue<int>>("M&S Queue      ", r, ops_per_thread);
+        bench_pipeline<faa_queue<int>>("FAA Queue      ", r, ops_per_thread);
+        bench_pipeline<fc_queue<int>>("FC Queue       ", r, ops_per_thread);
+        bench_pipeline<mpmc_ring<int>>("MPMC Ring      ", r, ops_per_thread, 1024);
+        if(r.consumers == 1)
+            bench_pipeline<mpsc_queue<int>>("MPSC Queue     ", r, ops_per_thread);
+        if(r.producers == 1 && r.consumers == 1)
+            bench_pipeline<spsc_ring<int>>("SPSC Ring      ", r, ops_per_thread, 1024);
+    }
+}
+
+/* Ordering deviation: threads fill the container with ticketed items,
+   then drain it, numbering removals as they happen. A strict container
+   hands out ticket r (FIFO) or N - 1 - r (LIFO) as removal r, so the
+   distance from that is the rank error of each removal. */
+template<typename C>
+static void bench_order(const string& name, int threads, int items_per_thread, bool lifo) {
+    C c;
+    long long n = 1LL * threads * items_per_thread;
+    atomic<int> ticket(0);
+    atomic<long long> removed(0), err_sum(0), err_max(0);
+
+    auto run = [&](auto&& body) {
+        vector<thread> ts;
+        for(int t = 0; t < threads; ++t) ts.emplace_back(body);
+        for(auto& th : ts) th.join();
     };
-    
-    vector<thread> ts;
-    for(int t = 0; t < 8; t++)
-        ts.emplace_back(worker);
-    
-    while(ready.load() < 8) { }
-    
     auto start = chrono::high_resolution_clock::now();
-    go.store(true); // Release all threads at once
-    
-    for(auto& t : ts) t.join();
+    run([&]() {
+        for(int i = 0; i < items_per_thread; ++i) insert_item(c, ticket++);
+    });
+    run([&]() {
+        long long local_sum = 0, local_max = 0;
+        int v;
+        while(remove_item(c, v)) {
+            long long r = removed++;
+            long long ideal = lifo ? n - 1 - r : r;
+            long long e = v > ideal ? v - ideal : ideal - v;
+            local_sum += e;
+            local_max = max(local_max, e);
+        }
+        err_sum += local_sum;
+        long long m = err_max.load();
+        while(local_max > m && !err_max.compare_exchange_weak(m, local_max)) {}
+    });
     auto end = chrono::high_resolution_clock::now();
-    
-    double ms = chrono::duration<double, milli>(end - start).count();
-    cout << "Time: " << ms << " ms (all threads competed simultaneously)" << endl;
+
+    double secs = chrono::duration<double>(end - start).count();
+    cout << "  " << name << "  threads=" << threads
+         << "  ops=" << 2 * n
+         << "  throughput=" << 2 * n / secs << " ops/s"
+         << "  rank_err mean=" << (double)err_sum.load() / n
+         << " max=" << err_max.load() << "\n";
 }
 
-/* Benchmark a stack with multiple thread counts */
-template<typename Stack>
-static void bench_stack(const string& name, int threads, int ops_per_thread) {
-    Stack s;
+/* Strict containers against their sharded, relaxed-order wrappers */
+static void bench_relaxed() {
+    const int ops_per_thread = 100000;
+    int thread_counts[] = {1, 2, 4, 8, 16};
 
-    for(int i = 0; i < threads * ops_per_thread; ++i)
-        s.push(i);
+    cout << "=== Relaxed Order Benchmarks ===\n";
+    for(int t : thread_counts) {
+        bench_stack<treiber_stack<int>>("Treiber Stack     ", t, ops_per_thread);
+        bench_stack<sharded_stack<treiber_stack<int>>>("Sharded Treiber   ", t, ops_per_thread);
+        bench_queue<msqueue<int>>("M&S Queue         ", t, ops_per_thread);
+        bench_queue<sharded_queue<msqueue<int>>>("Sharded M&S       ", t, ops_per_thread);
+        bench_queue<sgl_queue<int>>("SGL Queue         ", t, ops_per_thread);
+        bench_queue<sharded_queue<sgl_queue<int>>>("Sharded SGL Queue ", t, ops_per_thread);
+    }
 
-    auto worker = [&](int id) {
-        for(int i = 0; i < ops_per_thread; ++i) {
-            if((i & 1) == 0)
-                s.push(id * ops_per_thread + i);
-            else {
-                try { (void)s.pop(); } catch(...) {}
-            }
-        }
-    };
+    cout << "\n=== Ordering Deviation ===\n";
+    for(int t : thread_counts) {
+        bench_order<treiber_stack<int>>("Treiber Stack     ", t, ops_per_thread, true);
+        bench_order<sharded_stack<treiber_stack<int>>>("Sharded Treiber   ", t, ops_per_thread, true);
+        bench_order<msqueue<int>>("M&S Queue         ", t, ops_per_thread, false);
+        bench_order<sharded_queue<msqueue<int>>>("Sharded M&S       ", t, ops_per_thread, false);
+        bench_order<sgl_queue<int>>("SGL Queue         ", t, ops_per_thread, false);
+        bench_order<sharded_queue<sgl_queue<int>>>("Sharded SGL Queue ", t, ops_per_thread, false);
+    }
+}
 
-    vector<thread> ts;
+/* Fork-join fib: a task forks fib(n - 1) into the pool, runs fib(n - 2)
+   itself, then runs other pool tasks until its child is done. Below
+   FIB_CUTOFF it recurses serially. */
+static const int FIB_CUTOFF = 16;
+
+struct fib_task {
+    int n;
+    long long result;
+    atomic<bool> done;
+    explicit fib_task(int k) : n(k), result(0), done(false) {}
+};
+
+static long long fib_serial(int n) {
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+template<typename Pool>
+static long long fib_fork(Pool& pool, int self, int n);
+
+template<typename Pool>
+static void run_task(Pool& pool, int self, fib_task* t) {
+    t->result = fib_fork(pool, self, t->n);
+    t->done.store(true, memory_order_release);
+}
+
+template<typename Pool>
+static long long fib_fork(Pool& pool, int self, int n) {
+    if(n < FIB_CUTOFF) return fib_serial(n);
+    fib_task child(n - 1);
+    pool.put(self, &child);
+    long long b = fib_fork(pool, self, n - 2);
+    exp_backoff::state idle;
+    while(!child.done.load(memory_order_acquire)) {
+        if(fib_task* t = pool.get(self)) run_task(pool, self, t);
+        else idle.pause();
+    }
+    return child.result + b;
+}
+
+/* One Chase-Lev deque per worker: own tasks LIFO, steal FIFO from a
+   random victim */
+struct deque_pool {
+    vector<unique_ptr<ws_deque<fib_task*>>> deques;
+    explicit deque_pool(int workers) {
+        for(int i = 0; i < workers; i++) deques.emplace_back(new ws_deque<fib_task*>());
+    }
+    void put(int self, fib_task* t) { deques[self]->push_bottom(t); }
+    fib_task* get(int self) {
+        fib_task* t;
+        if(deques[self]->pop_bottom(t)) return t;
+        int victim = (int)thread_rng().below((uint32_t)deques.size());
+        if(victim != self && deques[victim]->steal(t)) return t;
+        return nullptr;
+    }
+};
+
+/* One stack of tasks shared by every worker */
+template<typename Stack>
+struct shared_pool {
+    Stack tasks;
+    explicit shared_pool(int) {}
+    void put(int, fib_task* t) { tasks.push(t); }
+    fib_task* get(int) {
+        fib_task* t;
+        return tasks.try_pop(t) ? t : nullptr;
+    }
+};
+
+/* Worker 0 is the calling thread and runs the root, the others take
+   tasks from the pool until the root returns */
+template<typename Pool>
+static void bench_forkjoin(const string& name, int threads, int n, long long expected) {
+    Pool pool(threads);
+    atomic<bool> stop(false);
     auto start = chrono::high_resolution_clock::now();
-    for(int t = 0; t < threads; ++t)
-        ts.emplace_back(worker, t);
-    for(auto& th : ts)
-        th.join();
+    vector<thread> ts;
+    for(int w = 1; w < threads; ++w) {
+        ts.emplace_back([&, w]() {
+            exp_backoff::state idle;
+            while(!stop.load(memory_order_relaxed)) {
+                if(fib_task* t = pool.get(w)) {
+                    run_task(pool, w, t);
+                    idle = exp_backoff::state();
+                } else {
+                    idle.pause();
+                }
+            }
+        });
+    }
+    long long r = fib_fork(pool, 0, n);
+    stop = true;
+    for(auto& th : ts) th.join();
     auto end = chrono::high_resolution_clock::now();
 
     double secs = chrono::duration<double>(end - start).count();
-    long long total_ops = 1LL * threads * ops_per_thread;
-    double throughput = total_ops / secs;
-
     cout << "  " << name << "  threads=" << threads
-              << "  ops=" << total_ops
-              << "  throughput=" << throughput << " ops/s\n";
+         << "  fib(" << n << ")=" << r << (r == expected ? "" : " WRONG")
+         << "  time=" << secs * 1000 << " ms\n";
 }
 
-/* Benchmark a queue with producer/consumer threads */
-template<typename Queue>
-static void bench_queue(const string& name, int threads, int ops_per_thread) {
-    Queue q;
+/* Work-stealing deques against a shared task stack */
+static void bench_steal() {
+    const int n = 35;
+    long long expected = fib_serial(n);
+    int thread_counts[] = {1, 2, 4, 8, 16};
+
+    cout << "=== Fork-Join Benchmarks ===\n";
+    for(int t : thread_counts) {
+        bench_forkjoin<deque_pool>("Chase-Lev Deques ", t, n, expected);
+        bench_forkjoin<shared_pool<treiber_stack<fib_task*>>>("Shared Treiber   ", t, n, expected);
+        bench_forkjoin<shared_pool<fc_stack<fib_task*>>>("Shared FC Stack  ", t, n, expected);
+    }
+}
 
+/* bounded_queue latency: std vs futex condvar, with and without the spin
+   phase, saturated and paced */
+/* Producers hand items over in runs of batch through enqueue_bulk,
+   consumers take up to batch at a time with dequeue_bulk_wait; batch 1
+   is the per-item enqueue/dequeue path. The last producer to finish
+   sends one -1 per consumer, and a consumer that takes more than one
+   puts the extras back. Wakeups per item show the saved handoffs. */
+template<typename Queue>
+static void bench_bulk_handoff(const string& name, pc_ratio r, int items_per_producer,
+                               size_t capacity, int batch) {
+    Queue q(capacity);
+    atomic<int> producing(r.producers);
     auto producer = [&](int id) {
-        for(int i = 0; i < ops_per_thread; ++i)
-            q.enqueue(id * ops_per_thread + i);
+        vector<long long> run(batch);
+        for(int i = 0; i < items_per_producer; i += batch) {
+            int k = min(batch, items_per_producer - i);
+            if(batch == 1) {
+                q.enqueue(id);
+                continue;
+            }
+            for(int j = 0; j < k; j++) run[j] = id;
+            q.enqueue_bulk(run.data(), k);
+        }
+        if(--producing == 0)
+            for(int c = 0; c < r.consumers; c++) q.enqueue(-1);
     };
-
-    auto consumer = [&](int /*id*/) {
-        for(int i = 0; i < ops_per_thread; ++i) {
-            try { (void)q.dequeue(); } catch(...) {}
+    auto consumer = [&]() {
+        vector<long long> got(batch);
+        while(true) {
+            size_t k = batch == 1 ? (got[0] = q.dequeue(), 1) : q.dequeue_bulk_wait(got.data(), batch);
+            size_t stops = (size_t)count(got.begin(), got.begin() + k, -1LL);
+            if(stops == 0) continue;
+            for(size_t i = 1; i < stops; i++) q.enqueue(-1);
+            return;
         }
     };
+    double secs = run_pinned(r.producers + r.consumers, bench_pin, bench_perf, [](int) {}, [&](int id) {
+        if(id < r.producers) producer(id);
+        else consumer();
+    });
+    long long items = 1LL * r.producers * items_per_producer;
 
-    int half = threads / 2;
-    if(half == 0) half = 1;
-    int prod_threads = half;
-    int cons_threads = threads - half;
-    if(cons_threads == 0) cons_threads = 1;
+    cout << "  " << name << "  threads=" << r.producers + r.consumers
+         << " (" << r.producers << ":" << r.consumers << ")"
+         << "  capacity=" << capacity << "  batch=" << batch
+         << "  throughput=" << items / secs << " items/s";
+#if CONTAINER_STATS
+    cout << "  wakeups/item=" << (double)collect_stats().v[STAT_CV_WAKEUPS] / items;
+#endif
+    cout << "\n";
+}
 
-    vector<thread> ts;
-    auto start = chrono::high_resolution_clock::now();
-    for(int t = 0; t < prod_threads; ++t)
-        ts.emplace_back(producer, t);
-    for(int t = 0; t < cons_threads; ++t)
-        ts.emplace_back(consumer, t);
-    for(auto& th : ts)
-        th.join();
-    auto end = chrono::high_resolution_clock::now();
+static void bench_condvar() {
+    const int items = 20000;
+    pc_ratio ratios[] = {{1, 1}, {4, 4}};
+    long long gaps[] = {0, 20000};
 
-    double secs = chrono::duration<double>(end - start).count();
-    long long total_ops = 1LL * ops_per_thread * (prod_threads + cons_threads);
-    double throughput = total_ops / secs;
+    cout << "=== Blocking Queue Benchmarks ===\n";
+    for(pc_ratio r : ratios) {
+        for(long long gap : gaps) {
+            bench_blocking<bounded_queue<long long>>("std   no-spin", r, items, gap, 0);
+            bench_blocking<bounded_queue<long long>>("std   spin   ", r, items, gap, CV_SPIN_MAX);
+#ifdef HAVE_FUTEX
+            bench_blocking<bounded_queue<long long, condvar_futex>>("futex no-spin", r, items, gap, 0);
+            bench_blocking<bounded_queue<long long, condvar_futex>>("futex spin   ", r, items, gap, CV_SPIN_MAX);
+#endif
+        }
+    }
 
-    cout << "  " << name << "  threads=" << threads
-              << "  ops=" << total_ops
-              << "  throughput=" << throughput << " ops/s\n";
+    cout << "\n=== Bounded Queue Bulk Handoff ===\n";
+    for(pc_ratio r : ratios) {
+        for(size_t capacity : {64, 1024}) {
+            for(int batch : {1, 16, 64}) {
+                bench_bulk_handoff<bounded_queue<long long>>("std  ", r, 200000, capacity, batch);
+#ifdef HAVE_FUTEX
+                bench_bulk_handoff<bounded_queue<long long, condvar_futex>>("futex", r, 200000, capacity, batch);
+#endif
+            }
+        }
+    }
+}
+
+/* Benchmark a map: every op draws a random key out of a space half
+   prefilled, reads_pct% are lookups and the rest split evenly between
+   insert and erase, so the size stays put */
+template<typename Map>
+static void bench_map(const string& name, int threads, int ops_per_thread, int reads_pct) {
+    const int key_space = 1 << 16;
+    Map m;
+    for(int k = 0; k < key_space; k += 2) m.insert(k, k);
+
+    auto worker = [&](int, int ops) {
+        xorshift64& rng = thread_rng();
+        int v;
+        for(int i = 0; i < ops; ++i) {
+            uint64_t r = rng.next();
+            int key = (int)(r >> 48);
+            int pick = (int)((r & 0xffffffff) % 100);
+            if(pick < reads_pct) (void)m.find(key, v);
+            else if(pick & 1) (void)m.insert(key, key);
+            else (void)m.erase(key);
+        }
+    };
+
+    double secs = run_pinned(threads, bench_pin, bench_perf,
+                             [&](int id) { worker(id, ops_per_thread / 10); },
+                             [&](int id) { worker(id, ops_per_thread); });
+    long long total_ops = 1LL * threads * ops_per_thread;
+    cout << "  " << name << "  threads=" << threads << "  reads=" << reads_pct << "%"
+         << "  ops=" << total_ops
+         << "  throughput=" << total_ops / secs << " ops/s";
+    print_stats(total_ops);
+    cout << "\n";
+}
+
+/* Read- and write-heavy mixes, the global-lock map against the
+   split-ordered one under each reclamation scheme and allocator */
+static void bench_maps() {
+    const int ops_per_thread = 100000;
+    int thread_counts[] = {1, 2, 4, 8, 16};
+
+    cout << "=== Hash Map Benchmarks ===\n";
+    for(int reads : {90, 10}) {
+        for(int t : thread_counts) {
+            bench_map<sgl_map<int, int>>("SGL Map           ", t, ops_per_thread, reads);
+            bench_map<split_ordered_map<int, int>>("Split-Ordered     ", t, ops_per_thread, reads);
+            bench_map<split_ordered_map<int, int, hash<int>, epoch_based>>("Split-Ordered EBR ", t, ops_per_thread, reads);
+            bench_map<split_ordered_map<int, int, hash<int>, hazard_pointers, pool_alloc>>("Split-Ordered pool", t, ops_per_thread, reads);
+        }
+    }
 }
 
 /* Run all benchmarks */
@@ -206,18 +2187,359 @@ static void run_benchmarks() {
 
     cout << "=== Stack Benchmarks ===\n";
     for(int t : thread_counts) {
-        bench_stack<sgl_stack>("SGL Stack      ", t, ops_per_thread);
-        bench_stack<treiber_stack>("Treiber Stack  ", t, ops_per_thread);
-        bench_stack<elimination_stack>("Elimination Stk", t, ops_per_thread);
-        bench_stack<fc_stack>("FC Stack       ", t, ops_per_thread);
+        bench_stack<sgl_stack<int>>("SGL Stack      ", t, ops_per_thread);
+        bench_stack<treiber_stack<int>>("Treiber Stack  ", t, ops_per_thread);
+        bench_stack<elimination_stack<int>>("Elimination Stk", t, ops_per_thread);
+        bench_stack<fc_stack<int>>("FC Stack       ", t, ops_per_thread);
+        bench_stack<adaptive_stack<int>>("Adaptive Stack ", t, ops_per_thread);
     }
 
     cout << "\n=== Queue Benchmarks ===\n";
     for(int t : thread_counts) {
-        bench_queue<sgl_queue>("SGL Queue      ", t, ops_per_thread);
-        bench_queue<msqueue>("M&S Queue      ", t, ops_per_thread);
-        bench_queue<fc_queue>("FC Queue       ", t, ops_per_thread);
+        bench_queue<sgl_queue<int>>("SGL Queue      ", t, ops_per_thread);
+        bench_queue<msqueue<int>>("M&S Queue      ", t, ops_per_thread);
+        bench_queue<faa_queue<int>>("FAA Queue      ", t, ops_per_thread);
+        bench_queue<fc_queue<int>>("FC Queue       ", t, ops_per_thread);
+    }
+
+    cout << "\n=== Hash Map Benchmarks ===\n";
+    for(int reads : {90, 10}) {
+        for(int t : thread_counts) {
+            bench_map<sgl_map<int, int>>("SGL Map        ", t, ops_per_thread, reads);
+            bench_map<split_ordered_map<int, int>>("Split-Ordered  ", t, ops_per_thread, reads);
+        }
+    }
+}
+
+/* One harness run: prefill, o.warmup untimed ops per thread, then every
+   thread draws insert or remove from the mix per op, inserting random
+   values so the priority queues see random keys, until it has done
+   o.ops ops or the duration is up. Every o.sample-th op is timed into the
+   thread's own histogram. */
+template<typename C>
+static bench_sample run_workload(const bench_options& o, int threads) {
+    C c;
+    for(long i = 0; i < o.prefill; ++i) insert_item(c, (int)i);
+
+    atomic<bool> stop(false);
+    vector<long long> done(threads);
+    vector<latency_histogram> lat(threads);
+    auto op = [&](xorshift64& rng) {
+        int v;
+        uint64_t r = rng.next();
+        if((int)((r & 0xffffffff) % 100) < o.insert_pct) insert_item(c, (int)(r >> 33));
+        else (void)remove_item(c, v);
+    };
+    auto warm = [&](int) {
+        xorshift64& rng = thread_rng();
+        for(long n = 0; n < o.warmup; ++n) op(rng);
+    };
+    auto worker = [&](int id) {
+        xorshift64& rng = thread_rng();
+        long long n = 0;
+        while(o.duration > 0 ? !stop.load(memory_order_relaxed) : n < o.ops) {
+            if(n % o.sample == 0) {
+                long long t0 = now_ns();
+                op(rng);
+                lat[id].record(now_ns() - t0);
+            } else {
+                op(rng);
+            }
+            ++n;
+        }
+        done[id] = n;
+    };
+    auto started = [&]() {
+        if(o.duration > 0) {
+            this_thread::sleep_for(chrono::duration<double>(o.duration));
+            stop.store(true);
+        }
+    };
+
+    bench_sample b;
+    b.secs = run_pinned(threads, o.pin, o.perf, warm, worker, started);
+    b.stats = collect_stats();
+    b.ops = accumulate(done.begin(), done.end(), 0LL);
+    for(const latency_histogram& h : lat) b.lat.merge(h);
+    return b;
+}
+
+/* Every thread count of the options, o.reps runs each */
+template<typename C>
+static void run_harness(const string& name, const bench_options& o, bench_report& rep) {
+    for(int t : o.threads) {
+        bench_row row{name, t, &o, {}};
+        for(int r = 0; r < o.reps; ++r) row.samples.push_back(run_workload<C>(o, t));
+        rep.add(row);
+    }
+}
+
+/* Containers the harness can drive, selected with -bench-<name> */
+struct harness_target {
+    const char* name;
+    void (*run)(const string&, const bench_options&, bench_report&);
+};
+
+static const harness_target harness_targets[] = {
+    {"sgl-stack", run_harness<sgl_stack<int>>},
+    {"treiber", run_harness<treiber_stack<int>>},
+    {"elimination", run_harness<elimination_stack<int>>},
+    {"fc-stack", run_harness<fc_stack<int>>},
+    {"adaptive", run_harness<adaptive_stack<int>>},
+    {"sharded-stack", run_harness<sharded_stack<treiber_stack<int>>>},
+    {"sgl-queue", run_harness<sgl_queue<int>>},
+    {"msqueue", run_harness<msqueue<int>>},
+    {"faa-queue", run_harness<faa_queue<int>>},
+    {"fc-queue", run_harness<fc_queue<int>>},
+    {"sharded-queue", run_harness<sharded_queue<msqueue<int>>>},
+    {"skiplist-pq", run_harness<skiplist_pq<int>>},
+    {"fc-heap", run_harness<fc_heap<int>>},
+};
+
+/* -bench-<name> [options], returns the exit status */
+static int run_harness_cli(const harness_target& target, int argc, char** argv) {
+    bench_options o;
+    try {
+        o = parse_bench_options(argc, argv, 2);
+    } catch(const invalid_argument& e) {
+        cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    ofstream file;
+    if(!o.out.empty()) {
+        file.open(o.out);
+        if(!file) {
+            cerr << "error: cannot write " << o.out << "\n";
+            return 1;
+        }
+    }
+    bench_report rep(o.format, o.out.empty() ? cout : file);
+    target.run(target.name, o, rep);
+    rep.finish();
+    return 0;
+}
+
+/* One stress run: threads draw inserts and removes from the mix until
+   the duration is up or each has done o.ops ops, logging every op into
+   its own history; the main thread prefills and finally drains, so its
+   history closes the account. Returns the violations check_history found. */
+template<typename C>
+static vector<string> run_stress(const bench_options& o, int threads, stress_order order,
+                                 bool check_empty, long long& ops) {
+    typedef int64_t V;
+    C c;
+    vector<stress_history> hist(threads + 1);
+    auto insert = [&](stress_history& h, int id) {
+        V v = stress_value(id, h.inserts.size());
+        long long inv = now_ns();
+        bool ok = try_insert(c, v, 0);
+        if(ok) h.inserts.push_back({inv, now_ns(), v});
+    };
+    auto remove = [&](stress_history& h) {
+        V v = -1;
+        long long inv = now_ns();
+        bool ok = remove_item(c, v);
+        (ok ? h.removes : h.empties).push_back({inv, now_ns(), v});
+    };
+    for(long i = 0; i < o.prefill; ++i) insert(hist[threads], threads);
+
+    atomic<bool> stop(false);
+    atomic<int> finished(0);
+    auto worker = [&](int id) {
+        xorshift64& rng = thread_rng();
+        stress_history& h = hist[id];
+        for(long n = 0; n < o.ops && !stop.load(memory_order_relaxed); ++n) {
+            if((int)rng.below(100) < o.insert_pct) insert(h, id);
+            else remove(h);
+        }
+        finished++;
+    };
+    auto started = [&]() {
+        long long end = now_ns() + (long long)(o.duration * 1e9);
+        while(finished.load() < threads && now_ns() < end)
+            this_thread::sleep_for(chrono::milliseconds(1));
+        stop.store(true);
+    };
+    run_pinned(threads, o.pin, false, [](int) {}, worker, started);
+
+    V v;
+    while(remove_item(c, v)) hist[threads].removes.push_back({now_ns(), now_ns(), v});
+    ops = 0;
+    for(const stress_history& h : hist) ops += h.inserts.size() + h.removes.size() + h.empties.size();
+    return check_history(hist, order, check_empty);
+}
+
+/* A ring small enough to run full, so failed inserts get exercised */
+struct stress_ring : mpmc_ring<int64_t> {
+    stress_ring() : mpmc_ring<int64_t>(64) {}
+};
+
+/* Starts out combining, so the runs also cross the mode changes down */
+struct stress_adaptive : adaptive_stack<int64_t> {
+    stress_adaptive() : adaptive_stack<int64_t>(ADAPT_COMBINING) {}
+};
+
+/* Everything -stress drives: every container with its non-default
+   policies that change the algorithm. The ring's failed dequeues are not
+   linearizable (a dequeuer stops at a cell whose enqueuer has claimed it
+   but not yet written), the sharded ones keep no order across shards,
+   and the priority queues order by value, so those are checked for
+   less. Blocking, single-consumer and owner-only containers
+   (bounded_queue, spsc/mpsc, ws_deque) do not fit a symmetric mix and
+   are covered by their own tests. */
+struct stress_target {
+    const char* name;
+    vector<string> (*run)(const bench_options&, int, stress_order, bool, long long&);
+    stress_order order;
+    bool check_empty;
+};
+
+static const stress_target stress_targets[] = {
+    {"sgl-stack", run_stress<sgl_stack<int64_t>>, ORDER_LIFO, true},
+    {"treiber", run_stress<treiber_stack<int64_t>>, ORDER_LIFO, true},
+    {"treiber-epoch", run_stress<treiber_stack<int64_t, epoch_based>>, ORDER_LIFO, true},
+    {"treiber-reuse", run_stress<treiber_stack<int64_t, immediate_reclaim, packed_ptr, pool_alloc>>, ORDER_LIFO, true},
+#ifdef HAVE_DWCAS
+    {"treiber-dwcas", run_stress<treiber_stack<int64_t, immediate_reclaim, dwcas_ptr, freelist_alloc>>, ORDER_LIFO, true},
+#endif
+    {"elimination", run_stress<elimination_stack<int64_t>>, ORDER_LIFO, true},
+    {"elimination-reuse", run_stress<elimination_stack<int64_t, immediate_reclaim, packed_ptr, freelist_alloc>>, ORDER_LIFO, true},
+    {"fc-stack", run_stress<fc_stack<int64_t>>, ORDER_LIFO, true},
+    {"fc-stack-nodes", run_stress<fc_stack<int64_t, padded_layout, exp_backoff, sim_topology<2>>>, ORDER_LIFO, true},
+    {"adaptive", run_stress<adaptive_stack<int64_t>>, ORDER_LIFO, true},
+    {"adaptive-combining", run_stress<stress_adaptive>, ORDER_LIFO, true},
+    {"sharded-stack", run_stress<sharded_stack<treiber_stack<int64_t>>>, ORDER_NONE, false},
+    {"sgl-queue", run_stress<sgl_queue<int64_t>>, ORDER_FIFO, true},
+    {"msqueue", run_stress<msqueue<int64_t>>, ORDER_FIFO, true},
+    {"msqueue-epoch", run_stress<msqueue<int64_t, epoch_based>>, ORDER_FIFO, true},
+    {"msqueue-reuse", run_stress<msqueue<int64_t, immediate_reclaim, packed_ptr, freelist_alloc>>, ORDER_FIFO, true},
+    {"faa-queue", run_stress<faa_queue<int64_t>>, ORDER_FIFO, true},
+    {"faa-queue-epoch", run_stress<faa_queue<int64_t, epoch_based>>, ORDER_FIFO, true},
+    {"fc-queue", run_stress<fc_queue<int64_t>>, ORDER_FIFO, true},
+    {"fc-queue-nodes", run_stress<fc_queue<int64_t, padded_layout, exp_backoff, sim_topology<2>>>, ORDER_FIFO, true},
+    {"mpmc-ring", run_stress<stress_ring>, ORDER_FIFO, false},
+    {"sharded-queue", run_stress<sharded_queue<msqueue<int64_t>>>, ORDER_NONE, false},
+    {"skiplist-pq", run_stress<skiplist_pq<int64_t>>, ORDER_NONE, false},
+    {"fc-heap", run_stress<fc_heap<int64_t>>, ORDER_NONE, false},
+};
+
+/* Stress every target (or the one named) at every thread count of the
+   options, printing one line per run. Returns the number of failed runs. */
+static int run_stress_all(const bench_options& o, const string& only, ostream& out) {
+    int failed = 0;
+    for(const stress_target& t : stress_targets) {
+        if(!only.empty() && only != t.name) continue;
+        for(int threads : o.threads) {
+            long long ops = 0;
+            vector<string> problems = t.run(o, threads, t.order, t.check_empty, ops);
+            out << "  " << t.name << string(20 - min<size_t>(19, strlen(t.name)), ' ')
+                << "threads=" << threads << "  ops=" << ops << "  "
+                << (problems.empty() ? "OK" : "FAIL") << "\n";
+            for(const string& p : problems) out << "    " << p << "\n";
+            if(!problems.empty()) failed++;
+        }
     }
+    return failed;
+}
+
+/* -stress [container] [options], returns the exit status */
+static int run_stress_cli(int argc, char** argv) {
+    bench_options defaults;
+    defaults.threads = {4};
+    defaults.duration = 0.5;
+    defaults.ops = 1000000;
+    defaults.prefill = 1000;
+    int first = 2;
+    string only;
+    if(argc > 2 && argv[2][0] != '-') only = argv[first++];
+    bench_options o;
+    try {
+        o = parse_bench_options(argc, argv, first, defaults);
+        if(!only.empty() && none_of(begin(stress_targets), end(stress_targets),
+                                    [&](const stress_target& t) { return only == t.name; }))
+            throw invalid_argument("unknown stress container " + only);
+    } catch(const invalid_argument& e) {
+        cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    cout << "=== Stress: conservation and ordering, " << o.duration << " s per run ===\n";
+    int failed = run_stress_all(o, only, cout);
+    cout << (failed ? "FAILED: " + to_string(failed) + " runs" : string("all runs passed")) << "\n";
+    return failed ? 1 : 0;
+}
+
+/* Histogram precision, option parsing, placement orders, and both run
+   modes of the harness */
+void test_harness() {
+    cout << "Testing Benchmark Harness... ";
+    latency_histogram h;
+    for(uint64_t v = 1; v <= 1000; v++) h.record(v);
+    assert(h.count() == 1000 && h.max() == 1000);
+    for(double p : {50.0, 90.0, 99.0, 99.9}) {
+        double exact = p * 10, got = (double)h.percentile(p);
+        assert(got >= exact * (1 - 1.0 / 32) && got <= exact * (1 + 1.0 / 32));
+    }
+    latency_histogram big;
+    big.record(1ull << 40);
+    big.merge(h);
+    assert(big.count() == 1001 && big.percentile(100) == 1ull << 40 && big.percentile(50) <= 520);
+
+    const char* args[] = {"prog", "-bench-x", "-threads", "1,3", "-mix", "90/10", "-reps", "2", "-format", "csv"};
+    bench_options o = parse_bench_options(10, const_cast<char**>(args), 2);
+    assert(o.threads == vector<int>({1, 3}) && o.insert_pct == 90 && o.reps == 2 && o.format == "csv");
+    const char* bad[] = {"prog", "-bench-x", "-mix", "90/20"};
+    bool threw = false;
+    try { parse_bench_options(4, const_cast<char**>(bad), 2); } catch(const invalid_argument&) { threw = true; }
+    assert(threw);
+
+    /* Every placement order is a permutation of the same CPUs */
+    assert(pin_order(PIN_NONE).empty());
+    vector<int> cpus = pin_order(PIN_COMPACT);
+    sort(cpus.begin(), cpus.end());
+    for(pin_policy p : {PIN_COMPACT, PIN_SCATTER, PIN_SMT}) {
+        vector<int> order = pin_order(p);
+        sort(order.begin(), order.end());
+        assert(!order.empty() && order == cpus && parse_pin_policy(pin_policy_name(p)) == p);
+    }
+
+    o.ops = 1000;
+    o.sample = 10;
+    o.warmup = 500;
+    o.pin = PIN_SCATTER;
+    bench_sample b = run_workload<treiber_stack<int>>(o, 3);
+    assert(b.ops == 3000 && b.lat.count() == 300);
+    o.duration = 0.05;
+    b = run_workload<msqueue<int>>(o, 2);
+    assert(b.ops > 0 && b.secs >= 0.05);
+    cout << "PASS" << endl;
+}
+
+/* The checker catches each kind of broken history, and a short stress
+   run of every container passes it */
+void test_stress() {
+    cout << "Testing Stress Histories... ";
+    vector<stress_history> h(2);
+    h[0].inserts = {{0, 10, stress_value(0, 0)}, {20, 30, stress_value(0, 1)}};
+    h[1].removes = {{40, 50, stress_value(0, 1)}, {60, 70, stress_value(0, 0)}};
+    assert(check_history(h, ORDER_LIFO, true).empty());
+    assert(check_history(h, ORDER_FIFO, true).size() == 1);
+    assert(check_history(h, ORDER_NONE, false).empty());
+    h[1].empties = {{52, 58, -1}};
+    assert(check_history(h, ORDER_LIFO, true).size() == 1);
+    h[1].empties.clear();
+    h[1].removes.push_back({80, 90, stress_value(0, 0)});
+    h[1].removes.push_back({80, 90, stress_value(1, 0)});
+    h[0].inserts.push_back({100, 110, stress_value(0, 2)});
+    assert(check_history(h, ORDER_LIFO, true).size() == 3);     /* twice, unknown, lost */
+
+    bench_options o;
+    o.threads = {3};
+    o.duration = 0.02;
+    o.ops = 20000;
+    o.prefill = 100;
+    ostringstream out;
+    assert(run_stress_all(o, "", out) == 0);
+    cout << "PASS" << endl;
 }
 
 /* Print usage */
@@ -227,14 +2549,34 @@ static void print_help(const char* prog) {
     cout << "  (no arguments)         Run unit tests\n";
     cout << "  -bench                 Run all benchmarks\n";
     cout << "  -contention            Run contention test\n";
-    cout << "  -bench-sgl-stack       Benchmark SGL Stack only\n";
-    cout << "  -bench-treiber         Benchmark Treiber Stack only\n";
-    cout << "  -bench-elimination     Benchmark Elimination Stack only\n";
-    cout << "  -bench-fc-stack        Benchmark FC Stack only\n";
-    cout << "  -bench-sgl-queue       Benchmark SGL Queue only\n";
-    cout << "  -bench-msqueue         Benchmark M&S Queue only\n";
-    cout << "  -bench-fc-queue        Benchmark FC Queue only\n";
+    cout << "  -stress [container] [options]\n";
+    cout << "                         Check every container's op history for conservation\n";
+    cout << "                         and ordering (default -threads 4 -duration 0.5)\n";
+    cout << "  -bench-<container> [options]\n";
+    cout << "                         Harness run on one container, see below\n";
+    cout << "  -bench-reclaim         Compare reclamation policies (throughput, RSS)\n";
+    cout << "  -bench-tagged          Compare plain, packed and 16-byte tagged pointers\n";
+    cout << "  -bench-alloc           Compare new, free-list and per-thread pool allocators\n";
+    cout << "  -bench-layout          Compare cache-line padded and packed layouts\n";
+    cout << "  -bench-batch           Sweep push_n/enqueue_bulk batch sizes\n";
+    cout << "  -bench-backoff         Compare none, yield, exponential and proportional backoff\n";
+    cout << "  -bench-numa            Flat vs per-node (hierarchical) flat combining\n";
+    cout << "  -bench-ring            Compare the MPMC ring with bounded_queue and M&S\n";
+    cout << "  -bench-condvar         bounded_queue latency, std vs futex condvar, spin vs none\n";
+    cout << "  -bench-wait            Busy-poll vs dequeue_wait on the lock-free queues\n";
+    cout << "  -bench-ratio           Sweep producer:consumer ratios incl. SPSC/MPSC queues\n";
+    cout << "  -bench-relaxed         Sharded relaxed-order containers, throughput and rank error\n";
+    cout << "  -bench-steal           Fork-join fib on work-stealing deques vs a shared stack\n";
+    cout << "  -bench-payload         Compare int, 64-byte POD and unique_ptr payloads\n";
+    cout << "  -bench-map             Hash maps, read- and write-heavy mixes\n";
     cout << "  -h, --help             Show this help\n";
+    cout << "  ... -pin POLICY        Thread placement for any -bench mode: none, compact\n";
+    cout << "                         (default), scatter or smt\n";
+    cout << "  ... -perf              Hardware counters per op for any -bench mode\n";
+    cout << "\nHarness containers:\n ";
+    for(const harness_target& t : harness_targets) cout << " " << t.name;
+    cout << "\n\nHarness options:\n";
+    print_bench_options(cout);
     cout << " \n";
     cout << "   For Perf : perf stat ./test_containers -bench\n"; 
 }
@@ -248,72 +2590,110 @@ int main(int argc, char** argv) {
             return 0;
         }
         
+        for(const harness_target& t : harness_targets)
+            if(arg == string("-bench-") + t.name) return run_harness_cli(t, argc, argv);
+        if(arg == "-stress") return run_stress_cli(argc, argv);
+        
+        /* The fixed benchmarks take -pin <policy> and -perf after the mode,
+           the harness above parses its own options */
+        for(int i = 2; i < argc; i++) {
+            string opt = argv[i];
+            try {
+                if(opt == "-perf") bench_perf = true;
+                else if(opt == "-pin" && i + 1 < argc) bench_pin = parse_pin_policy(argv[++i]);
+                else throw invalid_argument("unknown option " + opt);
+            } catch(const invalid_argument& e) {
+                cerr << "error: " << e.what() << "\n";
+                return 1;
+            }
+        }
+        
         if(arg == "-bench") {
             cout << "=== Concurrent Containers Benchmarks ===\n";
             run_benchmarks();
             return 0;
         }
         
-        if(arg == "-contention") {
-            test_contention();
+        if(arg == "-bench-reclaim") {
+            bench_reclaim();
+            return 0;
+        }
+        
+        if(arg == "-bench-tagged") {
+            bench_tagged();
+            return 0;
+        }
+        
+        if(arg == "-bench-alloc") {
+            bench_alloc();
+            return 0;
+        }
+        
+        if(arg == "-bench-layout") {
+            bench_layout();
+            return 0;
+        }
+        
+        if(arg == "-bench-batch") {
+            bench_batch();
+            return 0;
+        }
+        
+        if(arg == "-bench-backoff") {
+            bench_backoff();
+            return 0;
+        }
+        
+        if(arg == "-bench-numa") {
+            bench_numa();
+            return 0;
+        }
+        
+        if(arg == "-bench-ring") {
+            bench_ring();
             return 0;
         }
         
-        if(arg == "-bench-sgl-stack") {
-            cout << "=== SGL Stack Only ===\n";
-            int ops = 100000;
-            for(int t : {1,2,4,8,16})
-                bench_stack<sgl_stack>("SGL Stack", t, ops);
+        if(arg == "-bench-condvar") {
+            bench_condvar();
             return 0;
         }
         
-        if(arg == "-bench-treiber") {
-            cout << "=== Treiber Stack Only ===\n";
-            int ops = 100000;
-            for(int t : {1,2,4,8,16})
-                bench_stack<treiber_stack>("Treiber Stack", t, ops);
+        if(arg == "-bench-wait") {
+            bench_wait();
             return 0;
         }
         
-        if(arg == "-bench-elimination") {
-            cout << "=== Elimination Stack Only ===\n";
-            int ops = 100000;
-            for(int t : {1,2,4,8,16})
-                bench_stack<elimination_stack>("Elimination Stack", t, ops);
+        if(arg == "-bench-ratio") {
+            bench_ratio();
             return 0;
         }
         
-        if(arg == "-bench-fc-stack") {
-            cout << "=== FC Stack Only ===\n";
-            int ops = 100000;
-            for(int t : {1,2,4,8,16})
-                bench_stack<fc_stack>("FC Stack", t, ops);
+        if(arg == "-bench-steal") {
+            bench_steal();
             return 0;
         }
         
-        if(arg == "-bench-sgl-queue") {
-            cout << "=== SGL Queue Only ===\n";
-            int ops = 100000;
-            for(int t : {1,2,4,8,16})
-                bench_queue<sgl_queue>("SGL Queue", t, ops);
+        if(arg == "-bench-relaxed") {
+            bench_relaxed();
             return 0;
         }
         
-        if(arg == "-bench-msqueue") {
-            cout << "=== M&S Queue Only ===\n";
-            int ops = 100000;
-            for(int t : {1,2,4,8,16})
-                bench_queue<msqueue>("M&S Queue", t, ops);
+        if(arg == "-bench-payload") {
+            bench_payload();
+            return 0;
+        }
+
+        if(arg == "-bench-map") {
+            bench_maps();
             return 0;
         }
         
-        if(arg == "-bench-fc-queue") {
-            cout << "=== FC Queue Only ===\n";
-            int ops = 100000;
-            for(int t : {1,2,4,8,16})
-                bench_queue<fc_queue>("FC Queue", t, ops);
+        if(arg == "-contention") {
+            test_contention();
             return 0;
         }
+        
     }
     
     // Default: run unit tests
@@ -324,10 +2704,33 @@ int main(int argc, char** argv) {
     test_sgl_queue();
     test_treiber();
     test_msqueue();
+    test_faa_queue();
     test_elimination();
+    test_elimination_concurrent();
+    test_adaptive();
     test_fc_stack();
     test_fc_queue();
+    test_fc_many_threads();
+    test_fc_nodes();
+    test_cc_synch();
+    test_priority_queue();
+    test_map();
+    test_bulk();
+    test_try_pop();
+    test_generic();
+    test_reclaim();
+    test_tagged();
+    test_pool_alloc();
+    test_stats();
+    test_backoff();
     test_condvar();
+    test_blocking_pop();
+    test_mpmc_ring();
+    test_spsc_mpsc();
+    test_sharded();
+    test_ws_deque();
+    test_harness();
+    test_stress();
 
     cout << "\n=== ALL TESTS ARE PASSED ===" << endl;
     return 0;
@@ -0,0 +1,126 @@
+/*
+ * mpmc_ring.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Vyukov bounded MPMC ring - lock-free fixed-capacity queue.
+ */
+
+#ifndef MPMC_RING_H
+#define MPMC_RING_H
+
+#include "containers.h"
+
+/* Cell i starts out waiting for the producer of position i. Capacity is at
+   least 2 so the producer and consumer sequence numbers of one cell never
+   coincide. */
+template<typename T, typename Layout>
+mpmc_ring<T, Layout>::mpmc_ring(std::size_t capacity)
+    : cells(new cell[pow2_capacity(capacity, 2)]), mask(capacity - 1),
+      enqueue_pos(0), dequeue_pos(0) {
+    for(std::size_t i = 0; i < capacity; i++)
+        cells[i].seq.store(i, std::memory_order_relaxed);
+}
+
+/* Destructor: destroy the values still in the ring */
+template<typename T, typename Layout>
+mpmc_ring<T, Layout>::~mpmc_ring() {
+    std::size_t end = enqueue_pos.load();
+    for(std::size_t pos = dequeue_pos.load(); pos != end; pos++)
+        cells[pos & mask].val()->~T();
+    delete[] cells;
+}
+
+/* Claim the cell for the next enqueue position, null if the ring is full.
+   A cell whose sequence is behind pos still holds the value of the
+   previous lap, which its consumer has not taken yet. */
+template<typename T, typename Layout>
+typename mpmc_ring<T, Layout>::cell* mpmc_ring<T, Layout>::claim_enqueue(std::size_t& pos) {
+    pos = enqueue_pos.load(std::memory_order_relaxed);
+    while(true) {
+        cell* c = &cells[pos & mask];
+        std::size_t seq = c->seq.load(std::memory_order_acquire);
+        std::intptr_t dif = (std::intptr_t)seq - (std::intptr_t)pos;
+        if(dif == 0) {
+            if(enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return c;
+        } else if(dif < 0) {
+            return nullptr;
+        } else {
+            /* Another producer took pos, catch up */
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/* A claimed cell must be filled, so a value whose constructor may throw
+   is built before the claim and moved in after it */
+template<typename T, typename Layout>
+template<typename... Args>
+bool mpmc_ring<T, Layout>::try_emplace(Args&&... args) {
+    std::size_t pos;
+    if constexpr(std::is_nothrow_constructible<T, Args&&...>::value) {
+        cell* c = claim_enqueue(pos);
+        if(!c) return false;
+        new (c->storage) T(std::forward<Args>(args)...);
+        c->seq.store(pos + 1, std::memory_order_release);
+    } else {
+        T v(std::forward<Args>(args)...);
+        cell* c = claim_enqueue(pos);
+        if(!c) return false;
+        new (c->storage) T(std::move(v));
+        c->seq.store(pos + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+/* Take the value at the next dequeue position and hand the cell to the
+   producer one lap ahead, false if the ring is empty */
+template<typename T, typename Layout>
+bool mpmc_ring<T, Layout>::try_dequeue(T& out) {
+    std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    cell* c;
+    while(true) {
+        c = &cells[pos & mask];
+        std::size_t seq = c->seq.load(std::memory_order_acquire);
+        std::intptr_t dif = (std::intptr_t)seq - (std::intptr_t)(pos + 1);
+        if(dif == 0) {
+            if(dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if(dif < 0) {
+            return false;
+        } else {
+            pos = dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    out = std::move(*c->val());
+    c->val()->~T();
+    c->seq.store(pos + mask + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Layout>
+std::optional<T> mpmc_ring<T, Layout>::try_dequeue() {
+    T v;
+    if(!try_dequeue(v)) return std::nullopt;
+    return v;
+}
+
+/* Blocking enqueue: wait for a consumer to free a cell */
+template<typename T, typename Layout>
+void mpmc_ring<T, Layout>::enqueue(T&& value) {
+    for(int spin = 0; !try_enqueue(std::move(value)); spin++) {
+        if(spin >= RING_SPIN) std::this_thread::yield();
+    }
+}
+
+/* Blocking dequeue: wait for a producer to fill a cell */
+template<typename T, typename Layout>
+T mpmc_ring<T, Layout>::dequeue() {
+    T v;
+    for(int spin = 0; !try_dequeue(v); spin++) {
+        if(spin >= RING_SPIN) std::this_thread::yield();
+    }
+    return v;
+}
+
+#endif
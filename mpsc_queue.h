@@ -0,0 +1,91 @@
+/*
+ * mpsc_queue.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Vyukov intrusive MPSC queue and a value queue built on it.
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include "containers.h"
+
+/* Start with only the stub linked in */
+template<typename Node, typename Layout>
+intrusive_mpsc<Node, Layout>::intrusive_mpsc() : head(&stub), tail(&stub) {
+    stub.next.store(nullptr);
+}
+
+/* Producer: swing head to n with one exchange, then link the old head to
+   it. Until that store lands the consumer cannot see past the old head. */
+template<typename Node, typename Layout>
+void intrusive_mpsc<Node, Layout>::link(mpsc_hook* n) {
+    n->next.store(nullptr, std::memory_order_relaxed);
+    mpsc_hook* prev = head.exchange(n, std::memory_order_acq_rel);
+    prev->next.store(n, std::memory_order_release);
+}
+
+/* Consumer: a node is handed out only once its successor is linked, so no
+   producer still holds it as its prev. The stub is re-linked behind the
+   last node to give that node a successor. */
+template<typename Node, typename Layout>
+Node* intrusive_mpsc<Node, Layout>::pop() {
+    mpsc_hook* t = tail;
+    mpsc_hook* next = t->next.load(std::memory_order_acquire);
+    if(t == &stub) {
+        if(!next) return nullptr;
+        tail = next;
+        t = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if(next) {
+        tail = next;
+        return static_cast<Node*>(t);
+    }
+
+    /* t looks like the last node: if a producer has already swung head
+       past it, its link is on the way */
+    if(t != head.load(std::memory_order_acquire)) return nullptr;
+    link(&stub);
+    next = t->next.load(std::memory_order_acquire);
+    if(next) {
+        tail = next;
+        return static_cast<Node*>(t);
+    }
+    return nullptr;
+}
+
+/* Destructor: drain and free all nodes */
+template<typename T, typename Alloc, typename Layout>
+mpsc_queue<T, Alloc, Layout>::~mpsc_queue() {
+    while(node* n = q.pop())
+        Alloc::destroy(n);
+}
+
+/* Dequeue: throws if the queue is empty */
+template<typename T, typename Alloc, typename Layout>
+T mpsc_queue<T, Alloc, Layout>::dequeue() {
+    T v;
+    if(!try_dequeue(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+/* Non-throwing dequeue: a popped node is the consumer's alone, so it is
+   freed straight away without a reclamation scheme */
+template<typename T, typename Alloc, typename Layout>
+bool mpsc_queue<T, Alloc, Layout>::try_dequeue(T& out) {
+    node* n = q.pop();
+    if(!n) return false;
+    out = std::move(n->value);
+    Alloc::destroy(n);
+    return true;
+}
+
+template<typename T, typename Alloc, typename Layout>
+std::optional<T> mpsc_queue<T, Alloc, Layout>::try_dequeue() {
+    T v;
+    if(!try_dequeue(v)) return std::nullopt;
+    return v;
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * msqueue.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Michael & Scott Queue - lock-free FIFO queue with dummy node.
+ */
+
+#ifndef MSQUEUE_H
+#define MSQUEUE_H
+
+#include "containers.h"
+
+/* Initialize with dummy node to simplify empty queue handling */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::msqueue() {
+    node* dummy = Alloc::template create<node>();
+    dummy->next.store(nullptr);
+    head.store(dummy);
+    tail.store(dummy);
+}
+
+/* Destructor: drain and free all nodes, every node after the dummy still
+   holds a value */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::~msqueue() {
+    while(head.load().ptr != tail.load().ptr) {
+        node* n = head.load().ptr;
+        head.store(n->next.load().ptr);
+        head.load().ptr->val()->~T();
+        Alloc::destroy(n);
+    }
+    Alloc::destroy(head.load().ptr);
+}
+
+/* Lock-free enqueue with helping mechanism, the value is built in its node */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+template<typename... Args>
+void msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::emplace(Args&&... args) {
+    node* n = Alloc::template create<node>(std::in_place, std::forward<Args>(args)...);
+    n->next.store(nullptr);
+    append(n, n);
+    nonempty.notify();
+}
+
+/* Lock-free dequeue with helping mechanism */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+T msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::dequeue() {
+    T v;
+    if(!try_dequeue(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+/* Non-throwing dequeue: returns false if empty */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+bool msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::try_dequeue(T& out) {
+    return dequeue_bulk(&out, 1) == 1;
+}
+
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+std::optional<T> msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::try_dequeue() {
+    T v;
+    if(!try_dequeue(v)) return std::nullopt;
+    return v;
+}
+
+/* Blocking dequeue: spin, then sleep until an enqueue */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+T msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::dequeue_wait() {
+    T v;
+    await_item(nonempty, [&] { return try_dequeue(v); });
+    return v;
+}
+
+/* Timed dequeue: nullopt if nothing arrived before the timeout */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+template<typename Rep, typename Period>
+std::optional<T> msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::dequeue_for(const std::chrono::duration<Rep, Period>& timeout) {
+    T v;
+    if(!await_item(nonempty, [&] { return try_dequeue(v); }, wait_deadline(timeout))) return std::nullopt;
+    return v;
+}
+
+/* Link the batch into a private chain, then append it */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+void msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::enqueue_bulk(const T* values, std::size_t n) {
+    if(n == 0) return;
+    node* first = Alloc::template create<node>(std::in_place, values[0]);
+    node* end = first;
+    for(std::size_t i = 1; i < n; i++) {
+        node* n2 = Alloc::template create<node>(std::in_place, values[i]);
+        end->next.store(n2);
+        end = n2;
+    }
+    end->next.store(nullptr);
+    append(first, end);
+    nonempty.notify(n);
+}
+
+/* Hang the chain first..end off the last node with one CAS and swing
+   tail once to the end of the chain */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+void msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::append(node* first, node* end) {
+    typename Reclaim::guard g;
+    typename Backoff::state b;
+    
+    while(true) {
+        tagged<node> last = g.protect(0, tail);
+        tagged<node> next = last.ptr->next.load();
+        
+        /* Verify tail hasn't changed */
+        if(last == tail.load()) {
+            if(!next.ptr) {
+                /* Tail is at actual end, try to link the chain */
+                if(stat_cas(last.ptr->next.compare_exchange(next, first))) {
+                    /* Try to swing tail forward (can fail, another thread will help) */
+                    tail.compare_exchange(last, end);
+                    return;
+                }
+                b.pause();
+            } else {
+                /* Tail is lagging, help advance it */
+                tail.compare_exchange(last, next.ptr);
+            }
+        }
+    }
+}
+
+/* Copy a value out of a node that may be reused during the copy under
+   immediate_reclaim. This is a seqlock-style read: the bytes may be torn,
+   but they are only used if the head CAS that follows succeeds, which
+   proves the node was not recycled in between. TSan cannot see that
+   validation, so its builds copy with uninstrumented loads instead of
+   reporting the race. */
+#ifdef CONTAINERS_TSAN
+__attribute__((no_sanitize("thread")))
+inline void speculative_copy(void* dst, const void* src, std::size_t n) {
+    const volatile unsigned char* s = static_cast<const volatile unsigned char*>(src);
+    unsigned char* d = static_cast<unsigned char*>(dst);
+    for(std::size_t i = 0; i < n; i++) d[i] = s[i];
+}
+#else
+inline void speculative_copy(void* dst, const void* src, std::size_t n) { std::memcpy(dst, src, n); }
+#endif
+
+/* Dequeue up to n values, one CAS each, returns how many were dequeued
+   Note: first and next stay protected until first is retired, which is
+   what keeps next alive while a non-trivial value is moved out of it */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+std::size_t msqueue<T, Reclaim, Ptr, Alloc, Layout, Backoff>::dequeue_bulk(T* out, std::size_t n) {
+    typename Reclaim::guard g;
+    typename Backoff::state b;
+    std::size_t got = 0;
+    while(got < n) {
+        tagged<node> first = g.protect(0, head);
+        tagged<node> last = tail.load();
+        tagged<node> next = g.protect(1, first.ptr->next);
+        
+        /* Verify head hasn't changed */
+        if(first == head.load()) {
+            if(first.ptr == last.ptr) {
+                /* Queue appears empty or tail lagging */
+                if(!next.ptr) break;
+                
+                /* Help advance tail */
+                tail.compare_exchange(last, next.ptr);
+            } else if(std::is_trivially_copyable<T>::value) {
+                /* Queue has items, read value and try to advance head */
+                alignas(T) unsigned char v[sizeof(T)];
+                speculative_copy(v, next.ptr->storage, sizeof(T));
+                if(stat_cas(head.compare_exchange(first, next.ptr))) {
+                    g.clear(0);
+                    Reclaim::retire(first.ptr, free_node);
+                    std::memcpy(static_cast<void*>(&out[got++]), v, sizeof(T));
+                } else {
+                    b.pause();
+                }
+            } else {
+                /* Only the thread that advanced head may move the value */
+                if(stat_cas(head.compare_exchange(first, next.ptr))) {
+                    out[got++] = std::move(*next.ptr->val());
+                    next.ptr->val()->~T();
+                    g.clear(0);
+                    Reclaim::retire(first.ptr, free_node);
+                } else {
+                    b.pause();
+                }
+            }
+        }
+    }
+    return got;
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * numa.cpp
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Host NUMA topology from sysfs and getcpu().
+ */
+
+#include "numa.h"
+#include <fstream>
+#include <string>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* The online list reads like "0" or "0-3,6"; the count is the highest
+   node id + 1, so a hole in the numbering is just an idle node */
+CONTAINERS_LOCAL std::size_t online_nodes() {
+    std::ifstream in("/sys/devices/system/node/online");
+    std::string list;
+    if(!std::getline(in, list)) return 1;
+    std::size_t highest = 0, cur = 0;
+    bool digits = false;
+    for(char c : list) {
+        if(c >= '0' && c <= '9') {
+            cur = cur * 10 + (std::size_t)(c - '0');
+            digits = true;
+        } else {
+            if(digits && cur > highest) highest = cur;
+            cur = 0;
+            digits = false;
+        }
+    }
+    if(digits && cur > highest) highest = cur;
+    return highest + 1;
+}
+
+CONTAINERS_API std::size_t numa_topology::nodes() {
+    static const std::size_t n = online_nodes();
+    return n;
+}
+
+CONTAINERS_API std::size_t numa_topology::node() {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0, node = 0;
+    if(syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return node;
+#endif
+    return 0;
+}
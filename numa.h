@@ -0,0 +1,58 @@
+/*
+ * numa.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Thread-to-node topology policies for the combining containers.
+ *
+ * A topology is a stateless policy:
+ *   Topo::nodes()    number of nodes a container splits its combiners over
+ *   Topo::node()     node the calling thread runs on, taken modulo nodes()
+ * A thread is bound to a node when it first touches a container and keeps
+ * it, so a thread the scheduler later moves keeps combining on its old
+ * node; that costs remote traffic, not correctness.
+ */
+
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <atomic>
+#include <cstddef>
+#include "config.h"
+
+/* Threads are numbered in the order they first ask, from 0 */
+inline std::size_t thread_index() {
+    static std::atomic<std::size_t> next(0);
+    static thread_local std::size_t mine = next.fetch_add(1);
+    return mine;
+}
+
+/* One node: a single combiner owns the structure (plain flat combining) */
+struct flat_topology {
+    static constexpr const char* name = "flat";
+    static std::size_t nodes() { return 1; }
+    static std::size_t node() { return 0; }
+};
+
+/* The host's NUMA nodes: the count from sysfs, the current node from
+   getcpu(). Falls back to one node where neither is available. */
+struct numa_topology {
+    static constexpr const char* name = "numa";
+    static std::size_t nodes();
+    static std::size_t node();
+};
+
+/* N simulated nodes, threads dealt round robin. Exercises the hierarchy
+   and sweeps node counts on a host with fewer sockets. */
+template<std::size_t N>
+struct sim_topology {
+    static_assert(N > 0, "need at least one node");
+    static constexpr const char* name = "sim";
+    static std::size_t nodes() { return N; }
+    static std::size_t node() { return thread_index(); }
+};
+
+#ifdef CONTAINERS_HEADER_ONLY
+#include "numa.cpp"
+#endif
+
+#endif
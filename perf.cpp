@@ -0,0 +1,84 @@
+/*
+ * perf.cpp
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: perf_event_open(2) counters for the calling thread.
+ */
+
+#include "perf.h"
+#include "stats.h"
+#include <cstring>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const stat_id perf_stats[] = {STAT_PERF_CYCLES, STAT_PERF_INSNS, STAT_PERF_CACHE_MISSES};
+
+#if defined(__linux__)
+/* User-space only, so it works at perf_event_paranoid <= 2 */
+static int open_event(std::uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+thread_perf::thread_perf() {
+#if defined(__linux__)
+    static const std::uint64_t configs[EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES
+    };
+    for(int i = 0; i < EVENTS; i++) fds[i] = open_event(configs[i]);
+#else
+    for(int i = 0; i < EVENTS; i++) fds[i] = -1;
+#endif
+    for(int i = 0; i < EVENTS; i++) counts[i] = 0;
+}
+
+thread_perf::~thread_perf() {
+#if defined(__linux__)
+    for(int fd : fds)
+        if(fd >= 0) close(fd);
+#endif
+}
+
+bool thread_perf::available() const {
+    for(int fd : fds)
+        if(fd >= 0) return true;
+    return false;
+}
+
+void thread_perf::start() {
+#if defined(__linux__)
+    for(int fd : fds) {
+        if(fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+void thread_perf::stop() {
+#if defined(__linux__)
+    for(int i = 0; i < EVENTS; i++) {
+        if(fds[i] < 0) continue;
+        ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t v = 0;
+        if(read(fds[i], &v, sizeof(v)) == (ssize_t)sizeof(v)) counts[i] = v;
+    }
+#endif
+}
+
+void thread_perf::add_to_stats() const {
+    for(int i = 0; i < EVENTS; i++)
+        if(counts[i]) stat_add(perf_stats[i], counts[i]);
+}
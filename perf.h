@@ -0,0 +1,35 @@
+/*
+ * perf.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Per-thread hardware counters through perf_event_open(2).
+ *
+ * A benchmark thread opens its own set, runs the timed phase between
+ * start() and stop(), and adds the counts to its stats record:
+ *   thread_perf p;  p.start();  ...  p.stop();  p.add_to_stats();
+ * Counters the kernel refuses (no PMU in a VM, perf_event_paranoid) stay
+ * closed and add nothing, so callers never need to check.
+ */
+
+#ifndef PERF_H
+#define PERF_H
+
+#include <cstdint>
+
+class thread_perf {
+    static const int EVENTS = 3;        /* cycles, instructions, cache misses */
+    int fds[EVENTS];
+    std::uint64_t counts[EVENTS];
+public:
+    thread_perf();
+    ~thread_perf();
+    thread_perf(const thread_perf&) = delete;
+    thread_perf& operator=(const thread_perf&) = delete;
+
+    bool available() const;             /* at least one counter opened */
+    void start();
+    void stop();
+    void add_to_stats() const;          /* STAT_PERF_* of the calling thread */
+};
+
+#endif
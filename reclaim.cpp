@@ -0,0 +1,148 @@
+/*
+ * reclaim.cpp
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Hazard pointer and epoch-based reclamation domains.
+ */
+
+#include "reclaim.h"
+#include <algorithm>
+
+/* Records are never freed: a thread that exits marks its record inactive
+   and the next new thread adopts it, together with its retired list. */
+template<typename Record>
+CONTAINERS_LOCAL Record* acquire_record(std::atomic<Record*>& list, std::atomic<int>& count) {
+    for(Record* r = list.load(); r; r = r->next) {
+        bool expected = false;
+        if(!r->active.load() && r->active.compare_exchange_strong(expected, true))
+            return r;
+    }
+
+    Record* r = new Record();
+    r->active.store(true);
+    Record* old_head = list.load();
+    do {
+        r->next = old_head;
+    } while(!list.compare_exchange_weak(old_head, r));
+    count.fetch_add(1);
+    return r;
+}
+
+/* Free every retired node that passes the given check */
+template<typename Pred>
+CONTAINERS_LOCAL void free_retired(std::vector<retired_node>& retired, Pred can_free) {
+    std::size_t kept = 0;
+    for(std::size_t i = 0; i < retired.size(); i++) {
+        if(can_free(retired[i]))
+            retired[i].deleter(retired[i].ptr);
+        else
+            retired[kept++] = retired[i];
+    }
+    retired.resize(kept);
+}
+
+/* ---------- Hazard pointers ---------- */
+
+CONTAINERS_LOCAL std::atomic<hazard_pointers::record*> hp_list(nullptr);
+CONTAINERS_LOCAL std::atomic<int> hp_count(0);
+
+namespace detail {
+struct hp_owner {
+    hazard_pointers::record* rec;
+    hp_owner() : rec(acquire_record(hp_list, hp_count)) {
+        for(int i = 0; i < hazard_pointers::SLOTS; i++) rec->hp[i].store(nullptr);
+    }
+    ~hp_owner() {
+        for(int i = 0; i < hazard_pointers::SLOTS; i++) rec->hp[i].store(nullptr);
+        hazard_pointers::scan(rec);
+        rec->active.store(false);
+    }
+};
+}
+
+CONTAINERS_API hazard_pointers::record* hazard_pointers::local() {
+    static thread_local detail::hp_owner owner;
+    return owner.rec;
+}
+
+/* Collect all published hazards and free retired nodes not among them */
+CONTAINERS_API void hazard_pointers::scan(record* rec) {
+    std::vector<void*> hazards;
+    for(record* r = hp_list.load(); r; r = r->next) {
+        for(int i = 0; i < SLOTS; i++) {
+            void* p = r->hp[i].load();
+            if(p) hazards.push_back(p);
+        }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    free_retired(rec->retired, [&](const retired_node& n) {
+        return !std::binary_search(hazards.begin(), hazards.end(), n.ptr);
+    });
+}
+
+CONTAINERS_API void hazard_pointers::retire(void* p, reclaim_deleter d) {
+    record* rec = local();
+    rec->retired.push_back({p, d, 0});
+
+    /* Scan once the list is a constant factor larger than all hazards */
+    std::size_t threshold = 2 * SLOTS * (std::size_t)hp_count.load() + 64;
+    if(rec->retired.size() >= threshold) scan(rec);
+}
+
+/* ---------- Epoch-based reclamation ---------- */
+
+CONTAINERS_API std::atomic<std::uint64_t> epoch_based::global_epoch(1);
+CONTAINERS_LOCAL std::atomic<epoch_based::record*> ebr_list(nullptr);
+CONTAINERS_LOCAL std::atomic<int> ebr_count(0);
+
+namespace detail {
+struct ebr_owner {
+    epoch_based::record* rec;
+    ebr_owner() : rec(acquire_record(ebr_list, ebr_count)) {
+        rec->local.store(0);
+        rec->depth = 0;
+        rec->collected = 0;
+    }
+    ~ebr_owner() {
+        epoch_based::try_advance();
+        epoch_based::collect(rec);
+        rec->active.store(false);
+    }
+};
+}
+
+CONTAINERS_API epoch_based::record* epoch_based::local() {
+    static thread_local detail::ebr_owner owner;
+    return owner.rec;
+}
+
+/* Advance the global epoch if every pinned thread has observed it */
+CONTAINERS_API bool epoch_based::try_advance() {
+    std::uint64_t e = global_epoch.load();
+    for(record* r = ebr_list.load(); r; r = r->next) {
+        std::uint64_t l = r->local.load();
+        if((l & 1) && (l >> 1) != e) return false;
+    }
+    return global_epoch.compare_exchange_strong(e, e + 1);
+}
+
+/* Free nodes retired at least two epochs ago */
+CONTAINERS_API void epoch_based::collect(record* rec) {
+    std::uint64_t e = global_epoch.load();
+    if(e == rec->collected) return;
+    rec->collected = e;
+    free_retired(rec->retired, [&](const retired_node& n) {
+        return n.epoch + 2 <= e;
+    });
+}
+
+CONTAINERS_API void epoch_based::retire(void* p, reclaim_deleter d) {
+    record* rec = local();
+    rec->retired.push_back({p, d, global_epoch.load()});
+
+    if(rec->retired.size() % 64 == 0) {
+        try_advance();
+        collect(rec);
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ * reclaim.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Safe memory reclamation policies for the lock-free containers.
+ *
+ * Every policy exposes the same static interface so a container can be
+ * templated on it:
+ *   typename R::guard g;          enter a read-side critical region
+ *   g.protect(i, src)             load src and keep the result alive
+ *   R::retire(p, deleter)         free p once no thread can still see it
+ * src is either a std::atomic<node*> or one of the tagged_ptr.h policies.
+ */
+
+#ifndef RECLAIM_H
+#define RECLAIM_H
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include "tagged_ptr.h"
+#include "config.h"
+
+/* Deleter called once a retired node is safe to free */
+typedef void (*reclaim_deleter)(void*);
+
+struct retired_node {
+    void* ptr;
+    reclaim_deleter deleter;
+    std::uint64_t epoch;
+};
+
+/* No reclamation: retired nodes are leaked (original behaviour) */
+struct no_reclaim {
+    static constexpr const char* name = "leak";
+
+    class guard {
+    public:
+        template<typename A>
+        auto protect(int, const A& src) -> decltype(src.load()) { return src.load(); }
+        void clear(int) {}
+    };
+
+    static const bool immediate = false;
+    static void retire(void*, reclaim_deleter) {}
+};
+
+/* Immediate reuse: retired nodes go straight back to the allocator.
+   Only safe together with a tagged pointer policy (no ABA) and a
+   type-stable allocator (no use-after-unmap); containers enforce this. */
+struct immediate_reclaim {
+    static constexpr const char* name = "immediate";
+
+    class guard {
+    public:
+        template<typename A>
+        auto protect(int, const A& src) -> decltype(src.load()) { return src.load(); }
+        void clear(int) {}
+    };
+
+    static const bool immediate = true;
+    static void retire(void* p, reclaim_deleter d) { d(p); }
+};
+
+/* Hazard pointers (Michael 2004): each thread publishes the nodes it is
+   about to dereference, retired nodes are freed only when no thread has
+   them published. */
+struct hazard_pointers {
+    static constexpr const char* name = "hazard";
+    static const int SLOTS = 2;
+
+    struct record {
+        std::atomic<void*> hp[SLOTS];
+        std::atomic<bool> active;
+        std::vector<retired_node> retired;
+        record* next;
+    };
+
+    static record* local();
+    static void scan(record* rec);
+
+    class guard {
+        record* rec;
+    public:
+        guard() : rec(local()) {}
+        ~guard() {
+            for(int i = 0; i < SLOTS; i++)
+                rec->hp[i].store(nullptr, std::memory_order_release);
+        }
+        guard(const guard&) = delete;
+        guard& operator=(const guard&) = delete;
+
+        /* Publish src in slot i and re-check it has not changed meanwhile */
+        template<typename A>
+        auto protect(int i, const A& src) -> decltype(src.load()) {
+            auto p = src.load();
+            while(true) {
+                rec->hp[i].store(ptr_of(p));
+                auto again = src.load();
+                if(again == p) return p;
+                p = again;
+            }
+        }
+
+        void clear(int i) { rec->hp[i].store(nullptr, std::memory_order_release); }
+    };
+
+    static const bool immediate = false;
+    static void retire(void* p, reclaim_deleter d);
+};
+
+/* Epoch-based reclamation (Fraser 2004): threads pin the global epoch while
+   inside a guard, a node retired in epoch e is freed once the global epoch
+   has advanced to e + 2. */
+struct epoch_based {
+    static constexpr const char* name = "epoch";
+
+    struct record {
+        /* (epoch << 1) | 1 while pinned, 0 while quiescent */
+        std::atomic<std::uint64_t> local;
+        std::atomic<bool> active;
+        int depth;
+        std::uint64_t collected;    /* global epoch at the last collect */
+        std::vector<retired_node> retired;
+        record* next;
+    };
+
+    static std::atomic<std::uint64_t> global_epoch;
+
+    static record* local();
+    static bool try_advance();
+    static void collect(record* rec);
+
+    class guard {
+        record* rec;
+    public:
+        guard() : rec(local()) {
+            if(rec->depth++ == 0)
+                rec->local.store((global_epoch.load() << 1) | 1);
+        }
+        ~guard() {
+            if(--rec->depth == 0)
+                rec->local.store(0, std::memory_order_release);
+        }
+        guard(const guard&) = delete;
+        guard& operator=(const guard&) = delete;
+
+        template<typename A>
+        auto protect(int, const A& src) -> decltype(src.load()) { return src.load(); }
+        void clear(int) {}
+    };
+
+    static const bool immediate = false;
+    static void retire(void* p, reclaim_deleter d);
+};
+
+#ifdef CONTAINERS_HEADER_ONLY
+#include "reclaim.cpp"
+#endif
+
+#endif
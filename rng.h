@@ -0,0 +1,51 @@
+/*
+ * rng.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Per-thread xorshift PRNG for slot selection and backoff.
+ *
+ * rand() takes a global lock in glibc, which serializes exactly the
+ * threads elimination and backoff are meant to spread out.
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <atomic>
+#include <cstdint>
+
+/* xorshift64* (Vigna 2016): 64-bit state, good enough for slot picks */
+struct xorshift64 {
+    std::uint64_t state;
+
+    explicit xorshift64(std::uint64_t seed) : state(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+
+    std::uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1Dull;
+    }
+
+    /* Uniform-enough value in [0, n) without a division */
+    std::uint32_t below(std::uint32_t n) {
+        return (std::uint32_t)(((next() >> 32) * n) >> 32);
+    }
+};
+
+/* splitmix64 finaliser spreads consecutive thread numbers apart */
+inline std::uint64_t rng_seed() {
+    static std::atomic<std::uint64_t> counter(0);
+    std::uint64_t z = counter.fetch_add(1) + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/* Each thread gets its own generator with its own seed */
+inline xorshift64& thread_rng() {
+    static thread_local xorshift64 rng(rng_seed());
+    return rng;
+}
+
+#endif
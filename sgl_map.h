@@ -0,0 +1,55 @@
+/*
+ * sgl_map.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Single Global Lock Hash Map implementation.
+ */
+
+#ifndef SGL_MAP_H
+#define SGL_MAP_H
+
+#include "containers.h"
+
+/* Insert if absent: returns false and leaves the value if key is there */
+template<typename K, typename V, typename Hash>
+bool sgl_map<K, V, Hash>::insert(const K& key, const V& value) {
+    std::lock_guard<std::mutex> lk(lock);
+    return data.emplace(key, value).second;
+}
+
+template<typename K, typename V, typename Hash>
+bool sgl_map<K, V, Hash>::find(const K& key, V& out) {
+    std::lock_guard<std::mutex> lk(lock);
+    auto it = data.find(key);
+    if(it == data.end()) return false;
+    out = it->second;
+    return true;
+}
+
+template<typename K, typename V, typename Hash>
+std::optional<V> sgl_map<K, V, Hash>::find(const K& key) {
+    std::lock_guard<std::mutex> lk(lock);
+    auto it = data.find(key);
+    if(it == data.end()) return std::nullopt;
+    return it->second;
+}
+
+template<typename K, typename V, typename Hash>
+bool sgl_map<K, V, Hash>::contains(const K& key) {
+    std::lock_guard<std::mutex> lk(lock);
+    return data.count(key) != 0;
+}
+
+template<typename K, typename V, typename Hash>
+bool sgl_map<K, V, Hash>::erase(const K& key) {
+    std::lock_guard<std::mutex> lk(lock);
+    return data.erase(key) != 0;
+}
+
+template<typename K, typename V, typename Hash>
+std::size_t sgl_map<K, V, Hash>::size() {
+    std::lock_guard<std::mutex> lk(lock);
+    return data.size();
+}
+
+#endif
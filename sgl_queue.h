@@ -0,0 +1,83 @@
+/*
+ * sgl_queue.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Single Global Lock Queue implementation.
+ */
+
+#ifndef SGL_QUEUE_H
+#define SGL_QUEUE_H
+
+#include "containers.h"
+
+/* Enqueue value with mutex protection */
+template<typename T>
+void sgl_queue<T>::enqueue(const T& value) {
+    std::lock_guard<std::mutex> lk(lock);
+    data.push(value);
+}
+
+template<typename T>
+void sgl_queue<T>::enqueue(T&& value) {
+    std::lock_guard<std::mutex> lk(lock);
+    data.push(std::move(value));
+}
+
+/* Construct the value in place under the lock */
+template<typename T>
+template<typename... Args>
+void sgl_queue<T>::emplace(Args&&... args) {
+    std::lock_guard<std::mutex> lk(lock);
+    data.emplace(std::forward<Args>(args)...);
+}
+
+/* Dequeue value with mutex protection */
+template<typename T>
+T sgl_queue<T>::dequeue() {
+    std::lock_guard<std::mutex> lk(lock);
+    if(data.empty()) throw std::runtime_error("empty");
+    T v = std::move(data.front());
+    data.pop();
+    return v;
+}
+
+/* Non-throwing dequeue: returns false if empty */
+template<typename T>
+bool sgl_queue<T>::try_dequeue(T& out) {
+    std::lock_guard<std::mutex> lk(lock);
+    if(data.empty()) return false;
+    out = std::move(data.front());
+    data.pop();
+    return true;
+}
+
+template<typename T>
+std::optional<T> sgl_queue<T>::try_dequeue() {
+    std::lock_guard<std::mutex> lk(lock);
+    if(data.empty()) return std::nullopt;
+    std::optional<T> v(std::move(data.front()));
+    data.pop();
+    return v;
+}
+
+/* Enqueue a batch under one lock acquisition */
+template<typename T>
+void sgl_queue<T>::enqueue_bulk(const T* values, std::size_t n) {
+    std::lock_guard<std::mutex> lk(lock);
+    for(std::size_t i = 0; i < n; i++)
+        data.push(values[i]);
+}
+
+/* Dequeue up to n values under one lock acquisition, returns how many */
+template<typename T>
+std::size_t sgl_queue<T>::dequeue_bulk(T* out, std::size_t n) {
+    std::lock_guard<std::mutex> lk(lock);
+    std::size_t got = 0;
+    while(got < n && !data.empty()) {
+        out[got++] = std::move(data.front());
+        data.pop();
+    }
+    return got;
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * sgl_stack.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Single Global Lock Stack implementation.
+ */
+
+#ifndef SGL_STACK_H
+#define SGL_STACK_H
+
+#include "containers.h"
+
+/* Push value onto stack with mutex protection */
+template<typename T>
+void sgl_stack<T>::push(const T& value) {
+    std::lock_guard<std::mutex> lk(lock);
+    data.push(value);
+}
+
+template<typename T>
+void sgl_stack<T>::push(T&& value) {
+    std::lock_guard<std::mutex> lk(lock);
+    data.push(std::move(value));
+}
+
+/* Construct the value in place under the lock */
+template<typename T>
+template<typename... Args>
+void sgl_stack<T>::emplace(Args&&... args) {
+    std::lock_guard<std::mutex> lk(lock);
+    data.emplace(std::forward<Args>(args)...);
+}
+
+/* Pop value from stack with mutex protection */
+template<typename T>
+T sgl_stack<T>::pop() {
+    std::lock_guard<std::mutex> lk(lock);
+    if(data.empty()) throw std::runtime_error("empty");
+    T v = std::move(data.top());
+    data.pop();
+    return v;
+}
+
+/* Non-throwing pop: returns false if empty */
+template<typename T>
+bool sgl_stack<T>::try_pop(T& out) {
+    std::lock_guard<std::mutex> lk(lock);
+    if(data.empty()) return false;
+    out = std::move(data.top());
+    data.pop();
+    return true;
+}
+
+template<typename T>
+std::optional<T> sgl_stack<T>::try_pop() {
+    std::lock_guard<std::mutex> lk(lock);
+    if(data.empty()) return std::nullopt;
+    std::optional<T> v(std::move(data.top()));
+    data.pop();
+    return v;
+}
+
+/* Push a batch under one lock acquisition (values[n-1] ends on top) */
+template<typename T>
+void sgl_stack<T>::push_n(const T* values, std::size_t n) {
+    std::lock_guard<std::mutex> lk(lock);
+    for(std::size_t i = 0; i < n; i++)
+        data.push(values[i]);
+}
+
+/* Pop up to n values under one lock acquisition, returns how many */
+template<typename T>
+std::size_t sgl_stack<T>::pop_n(T* out, std::size_t n) {
+    std::lock_guard<std::mutex> lk(lock);
+    std::size_t got = 0;
+    while(got < n && !data.empty()) {
+        out[got++] = std::move(data.top());
+        data.pop();
+    }
+    return got;
+}
+
+#endif
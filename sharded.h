@@ -0,0 +1,151 @@
+/*
+ * sharded.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Sharded stack and queue - relaxed order for throughput.
+ */
+
+#ifndef SHARDED_H
+#define SHARDED_H
+
+#include "containers.h"
+#include "rng.h"
+
+template<typename C, typename Layout>
+shard_set<C, Layout>::shard_set(std::size_t n) : shards(nullptr), count(n) {
+    if(n == 0) throw std::invalid_argument("need at least one shard");
+    shards = new shard[n];
+}
+
+/* Consecutive threads get consecutive home shards */
+template<typename C, typename Layout>
+typename shard_set<C, Layout>::shard& shard_set<C, Layout>::home() {
+    return shards[thread_index() % count];
+}
+
+/* Collect up to n items with from(shard, want) -> got: home shard, then
+   the fuller of two random shards, then a sweep over all of them */
+template<typename C, typename Layout>
+template<typename Take>
+std::size_t shard_set<C, Layout>::take(std::size_t n, Take&& from) {
+    std::size_t got = 0;
+    auto drain = [&](shard& s) {
+        std::size_t k = from(s, n - got);
+        if(k) s.size.fetch_sub((long)k, std::memory_order_relaxed);
+        got += k;
+        return got == n;
+    };
+
+    shard& h = home();
+    if(h.size.load(std::memory_order_relaxed) > 0 && drain(h)) return got;
+    if(count > 1) {
+        shard& a = shards[thread_rng().below((std::uint32_t)count)];
+        shard& b = shards[thread_rng().below((std::uint32_t)count)];
+        shard& v = a.size.load(std::memory_order_relaxed) >= b.size.load(std::memory_order_relaxed) ? a : b;
+        if(v.size.load(std::memory_order_relaxed) > 0 && drain(v)) return got;
+    }
+
+    /* Sizes lag the containers, so only a sweep may report empty */
+    std::size_t start = thread_index() % count;
+    for(std::size_t i = 0; i < count; i++)
+        if(drain(shards[(start + i) % count])) break;
+    return got;
+}
+
+/* ---------- sharded_stack ---------- */
+
+template<typename Stack, typename Layout>
+template<typename... Args>
+void sharded_stack<Stack, Layout>::emplace(Args&&... args) {
+    typename base::shard& s = this->home();
+    s.c.emplace(std::forward<Args>(args)...);
+    s.size.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* Pop: throws if every shard is empty */
+template<typename Stack, typename Layout>
+typename sharded_stack<Stack, Layout>::T sharded_stack<Stack, Layout>::pop() {
+    T v;
+    if(!try_pop(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+template<typename Stack, typename Layout>
+bool sharded_stack<Stack, Layout>::try_pop(T& out) {
+    return pop_n(&out, 1) == 1;
+}
+
+template<typename Stack, typename Layout>
+std::optional<typename sharded_stack<Stack, Layout>::T> sharded_stack<Stack, Layout>::try_pop() {
+    T v;
+    if(!try_pop(v)) return std::nullopt;
+    return v;
+}
+
+/* The whole batch goes to the home shard in one bulk push */
+template<typename Stack, typename Layout>
+void sharded_stack<Stack, Layout>::push_n(const T* values, std::size_t n) {
+    typename base::shard& s = this->home();
+    s.c.push_n(values, n);
+    s.size.fetch_add((long)n, std::memory_order_relaxed);
+}
+
+template<typename Stack, typename Layout>
+std::size_t sharded_stack<Stack, Layout>::pop_n(T* out, std::size_t n) {
+    std::size_t got = 0;
+    return this->take(n, [&](typename base::shard& s, std::size_t want) {
+        std::size_t k = s.c.pop_n(out + got, want);
+        got += k;
+        return k;
+    });
+}
+
+/* ---------- sharded_queue ---------- */
+
+template<typename Queue, typename Layout>
+template<typename... Args>
+void sharded_queue<Queue, Layout>::emplace(Args&&... args) {
+    typename base::shard& s = this->home();
+    s.c.emplace(std::forward<Args>(args)...);
+    s.size.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* Dequeue: throws if every shard is empty */
+template<typename Queue, typename Layout>
+typename sharded_queue<Queue, Layout>::T sharded_queue<Queue, Layout>::dequeue() {
+    T v;
+    if(!try_dequeue(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+template<typename Queue, typename Layout>
+bool sharded_queue<Queue, Layout>::try_dequeue(T& out) {
+    return dequeue_bulk(&out, 1) == 1;
+}
+
+template<typename Queue, typename Layout>
+std::optional<typename sharded_queue<Queue, Layout>::T> sharded_queue<Queue, Layout>::try_dequeue() {
+    T v;
+    if(!try_dequeue(v)) return std::nullopt;
+    return v;
+}
+
+/* The whole batch goes to the home shard in one bulk enqueue */
+template<typename Queue, typename Layout>
+void sharded_queue<Queue, Layout>::enqueue_bulk(const T* values, std::size_t n) {
+    typename base::shard& s = this->home();
+    s.c.enqueue_bulk(values, n);
+    s.size.fetch_add((long)n, std::memory_order_relaxed);
+}
+
+template<typename Queue, typename Layout>
+std::size_t sharded_queue<Queue, Layout>::dequeue_bulk(T* out, std::size_t n) {
+    std::size_t got = 0;
+    return this->take(n, [&](typename base::shard& s, std::size_t want) {
+        std::size_t k = s.c.dequeue_bulk(out + got, want);
+        got += k;
+        return k;
+    });
+}
+
+#endif
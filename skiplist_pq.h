@@ -0,0 +1,207 @@
+/*
+ * skiplist_pq.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Skiplist Priority Queue - lock-free delete-min with batched unlinking.
+ */
+
+#ifndef SKIPLIST_PQ_H
+#define SKIPLIST_PQ_H
+
+#include "containers.h"
+#include "rng.h"
+#include <new>
+
+/* A node and its links in one allocation, links cleared */
+template<typename T, typename Compare>
+typename skiplist_pq<T, Compare>::node* skiplist_pq<T, Compare>::alloc_node(int height) {
+    void* mem = ::operator new(sizeof(node) + height * sizeof(std::atomic<std::uintptr_t>));
+    node* n = new(mem) node;
+    n->next = reinterpret_cast<std::atomic<std::uintptr_t>*>(static_cast<char*>(mem) + sizeof(node));
+    for(int i = 0; i < height; i++) new(&n->next[i]) std::atomic<std::uintptr_t>(0);
+    n->height = height;
+    n->inserting.store(false, std::memory_order_relaxed);
+    return n;
+}
+
+/* Free a node that holds a value (every node but the head) */
+template<typename T, typename Compare>
+void skiplist_pq<T, Compare>::free_node(void* p) {
+    node* n = static_cast<node*>(p);
+    n->val()->~T();
+    n->~node();
+    ::operator delete(p);
+}
+
+/* Geometric heights, one level in two goes up */
+template<typename T, typename Compare>
+int skiplist_pq<T, Compare>::random_height() {
+    std::uint64_t r = thread_rng().next();
+    int h = 1;
+    while(h < PQ_LEVELS && (r & 1)) {
+        h++;
+        r >>= 1;
+    }
+    return h;
+}
+
+/* Destructor: free the list, deleted prefix included; whatever was
+   already unlinked belongs to the epoch reclaimer */
+template<typename T, typename Compare>
+skiplist_pq<T, Compare>::~skiplist_pq() {
+    node* n = ref(head->next[0].load());
+    while(n) {
+        node* next = ref(n->next[0].load());
+        free_node(n);
+        n = next;
+    }
+    head->~node();
+    ::operator delete(head);
+}
+
+/* Predecessors and successors of key on every level. Deleted nodes are
+   walked past, so preds[0] is the last deleted node or a live node less
+   than key. Returns the last deleted node passed on the bottom level. */
+template<typename T, typename Compare>
+typename skiplist_pq<T, Compare>::node*
+skiplist_pq<T, Compare>::locate_preds(const T& key, node** preds, node** succs) {
+    node* x = head;
+    node* del = nullptr;
+    int i = PQ_LEVELS - 1;
+    while(i >= 0) {
+        std::uintptr_t w = x->next[i].load();
+        bool d = marked(w);             /* bottom level: the successor is deleted */
+        node* nx = ref(w);
+        if(nx && ((i == 0 && d) || marked(nx->next[0].load()) || less(*nx->val(), key))) {
+            if(i == 0 && d) del = nx;
+            x = nx;
+        } else {
+            preds[i] = x;
+            succs[i] = nx;
+            i--;
+        }
+    }
+    return del;
+}
+
+/* Move head's upper links past the deleted prefix, top level down */
+template<typename T, typename Compare>
+void skiplist_pq<T, Compare>::restructure() {
+    node* pred = head;
+    int i = PQ_LEVELS - 1;
+    while(i > 0) {
+        std::uintptr_t h = head->next[i].load();
+        node* hn = ref(h);
+        if(!hn || !marked(hn->next[0].load())) {
+            i--;
+            continue;
+        }
+        node* cur = ref(pred->next[i].load());
+        while(cur && marked(cur->next[0].load())) {
+            pred = cur;
+            cur = ref(pred->next[i].load());
+        }
+        if(head->next[i].compare_exchange_strong(h, word(cur))) i--;
+    }
+}
+
+/* Insert: link the bottom level after the deleted prefix with one CAS,
+   then the upper levels; those stop as soon as the node or its successor
+   is deleted, since a prefix node needs no shortcuts */
+template<typename T, typename Compare>
+template<typename... Args>
+void skiplist_pq<T, Compare>::emplace(Args&&... args) {
+    epoch_based::guard g;
+    int height = random_height();
+    node* n = alloc_node(height);
+    new(n->storage) T(std::forward<Args>(args)...);
+    n->inserting.store(true, std::memory_order_relaxed);
+
+    node* preds[PQ_LEVELS];
+    node* succs[PQ_LEVELS];
+    node* del;
+    while(true) {
+        del = locate_preds(*n->val(), preds, succs);
+        std::uintptr_t expected = word(succs[0]);
+        n->next[0].store(expected, std::memory_order_relaxed);
+        if(stat_cas(preds[0]->next[0].compare_exchange_strong(expected, word(n)))) break;
+    }
+    for(int i = 1; i < height;) {
+        n->next[i].store(word(succs[i]));
+        if(marked(n->next[0].load()) || (succs[i] && marked(succs[i]->next[0].load())) ||
+           (del && del == succs[i]))
+            break;
+        std::uintptr_t expected = word(succs[i]);
+        if(preds[i]->next[i].compare_exchange_strong(expected, word(n))) {
+            i++;
+            continue;
+        }
+        del = locate_preds(*n->val(), preds, succs);
+        if(succs[0] != n) break;
+    }
+    n->inserting.store(false, std::memory_order_release);
+}
+
+template<typename T, typename Compare>
+T skiplist_pq<T, Compare>::pop() {
+    T v;
+    if(!try_pop(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+/* Delete-min: walk the bottom level setting delete bits until one was
+   not yet set, which claims that node. A long enough prefix is unlinked
+   in one CAS on head, up to the first node still being inserted, whose
+   inserter may yet link it from an upper level. */
+template<typename T, typename Compare>
+bool skiplist_pq<T, Compare>::try_pop(T& out) {
+    epoch_based::guard g;
+    node* x = head;
+    std::uintptr_t obs_head = head->next[0].load();
+    node* newhead = nullptr;
+    int offset = 0;
+    std::uintptr_t nx;
+    do {
+        if(!ref(x->next[0].load())) return false;
+        if(!newhead && x->inserting.load()) newhead = x;
+        nx = x->next[0].fetch_or(1);
+        offset++;
+        x = ref(nx);
+    } while(marked(nx));
+    out = *x->val();
+
+    if(offset >= PQ_BOUND_OFFSET) {
+        if(!newhead) newhead = x;
+        std::uintptr_t expected = obs_head;
+        if(head->next[0].compare_exchange_strong(expected, word(newhead, true))) {
+            restructure();
+            for(node* n = ref(obs_head); n != newhead;) {
+                node* next = ref(n->next[0].load());
+                epoch_based::retire(n, free_node);
+                n = next;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename T, typename Compare>
+std::optional<T> skiplist_pq<T, Compare>::try_pop() {
+    T v;
+    if(!try_pop(v)) return std::nullopt;
+    return v;
+}
+
+template<typename T, typename Compare>
+void skiplist_pq<T, Compare>::push_n(const T* values, std::size_t n) {
+    for(std::size_t i = 0; i < n; i++) emplace(values[i]);
+}
+
+template<typename T, typename Compare>
+std::size_t skiplist_pq<T, Compare>::pop_n(T* out, std::size_t n) {
+    std::size_t got = 0;
+    while(got < n && try_pop(out[got])) got++;
+    return got;
+}
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ * split_ordered_map.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Split-Ordered Hash Map - lock-free hash map with incremental resizing.
+ */
+
+#ifndef SPLIT_ORDERED_MAP_H
+#define SPLIT_ORDERED_MAP_H
+
+#include "containers.h"
+
+/* Bit reversal: the order of a bucket's items in the list is the order of
+   their reversed hashes, so a bucket splits in place when the count doubles */
+inline std::uint64_t reverse_bits(std::uint64_t x) {
+    x = ((x >> 1) & 0x5555555555555555ull) | ((x & 0x5555555555555555ull) << 1);
+    x = ((x >> 2) & 0x3333333333333333ull) | ((x & 0x3333333333333333ull) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((x & 0x0F0F0F0F0F0F0F0Full) << 4);
+    return __builtin_bswap64(x);
+}
+
+/* Items get odd split-order keys and bucket dummies even ones, so a
+   dummy sorts before every item of its bucket */
+inline std::uint64_t so_item(std::uint64_t h) { return reverse_bits(h | (1ull << 63)); }
+inline std::uint64_t so_dummy(std::uint64_t b) { return reverse_bits(b); }
+
+/* Bucket 0 exists from the start, every other one is linked in lazily */
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::split_ordered_map(std::size_t initial_buckets)
+    : buckets(pow2_capacity(initial_buckets, 1)) {
+    for(int s = 0; s < SEGMENTS; s++) segments[s].store(nullptr, std::memory_order_relaxed);
+    slot(0).store(Alloc::template create<node>(so_dummy(0)));
+}
+
+/* Destructor: free the list, dummies and marked items included; whatever
+   was already unlinked belongs to the reclaimer */
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::~split_ordered_map() {
+    node* n = slot(0).load();
+    while(n) {
+        node* next = n->next.load().ptr;
+        Alloc::destroy(n);
+        n = next;
+    }
+    for(int s = 0; s < SEGMENTS; s++) delete[] segments[s].load();
+}
+
+/* std::hash is the identity for integers; the splitmix64 finaliser
+   spreads sequential keys over the buckets */
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+std::uint64_t split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::hash_of(const K& key) {
+    std::uint64_t z = (std::uint64_t)Hash()(key);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/* Directory entry of bucket b, allocating its segment on first use */
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+std::atomic<typename split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::node*>&
+split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::slot(std::size_t b) {
+    int s = b == 0 ? 0 : 64 - __builtin_clzll(b);
+    std::size_t first = s == 0 ? 0 : (std::size_t)1 << (s - 1);
+    std::atomic<node*>* seg = segments[s].load(std::memory_order_acquire);
+    if(!seg) {
+        std::size_t n = s == 0 ? 1 : first;
+        std::atomic<node*>* fresh = new std::atomic<node*>[n]();
+        if(segments[s].compare_exchange_strong(seg, fresh)) seg = fresh;
+        else delete[] fresh;
+    }
+    return seg[b - first];
+}
+
+/* Dummy of bucket b. A new bucket splits from its parent, b without its
+   top bit, whose dummy comes first in the list; the dummy is linked into
+   the list before it is published in the directory, so two threads that
+   race here agree on one node. */
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+typename split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::node*
+split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::bucket(std::size_t b, typename Reclaim::guard& g) {
+    std::atomic<node*>& entry = slot(b);
+    node* d = entry.load(std::memory_order_acquire);
+    if(d) return d;
+
+    std::size_t parent = b & ~((std::size_t)1 << (63 - __builtin_clzll(b)));
+    node* start = bucket(parent, g);
+    d = Alloc::template create<node>(so_dummy(b));
+    marked_ptr<node>* prev;
+    node* cur;
+    while(true) {
+        if(find(start, d->so, nullptr, prev, cur, g)) {
+            Alloc::destroy(d);
+            d = cur;
+            break;
+        }
+        d->next.store(cur);
+        link expected{cur, 0};
+        if(stat_cas(prev->compare_exchange(expected, {d, 0}))) break;
+    }
+    node* none = nullptr;
+    entry.compare_exchange_strong(none, d);
+    return d;
+}
+
+/* Harris-Michael search from a dummy for the first node at or after
+   (so, key), with prev the link that points to it. Marked nodes on the
+   way are unlinked and retired. Two hazard slots leapfrog: one holds cur,
+   the other the node prev lives in; dummies are never freed. key is null
+   when looking for a dummy. */
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+bool split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::find(node* start, std::uint64_t so, const K* key,
+                                                                 marked_ptr<node>*& prev, node*& cur,
+                                                                 typename Reclaim::guard& g) {
+    while(true) {
+        prev = &start->next;
+        int hp = 0;
+        link c = g.protect(hp, *prev);
+        while(true) {
+            cur = c.ptr;
+            if(!cur) return false;
+            link next = cur->next.load();
+            if(next.tag) {
+                /* cur is deleted: unlink it on the way */
+                link expected{cur, 0};
+                if(!stat_cas(prev->compare_exchange(expected, {next.ptr, 0}))) break;
+                Reclaim::retire(cur, free_node);
+                c = g.protect(hp, *prev);
+            } else {
+                if(cur->so > so) return false;
+                if(cur->so == so && (!key || cur->item->first == *key)) return true;
+                prev = &cur->next;
+                hp ^= 1;
+                c = g.protect(hp, *prev);
+            }
+            /* prev's node was deleted meanwhile: start over */
+            if(c.tag) break;
+        }
+    }
+}
+
+/* Insert if absent: link a new item after the last node before it with
+   one CAS, then double the bucket count once the load passes MAP_LOAD */
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+bool split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::insert(const K& key, const V& value) {
+    std::uint64_t h = hash_of(key), so = so_item(h);
+    typename Reclaim::guard g;
+    node* start = bucket(h & (buckets.load() - 1), g);
+    node* n = nullptr;
+    marked_ptr<node>* prev;
+    node* cur;
+    while(true) {
+        if(find(start, so, &key, prev, cur, g)) {
+            if(n) Alloc::destroy(n);
+            return false;
+        }
+        if(!n) n = Alloc::template create<node>(so, key, value);
+        n->next.store(cur);
+        link expected{cur, 0};
+        if(stat_cas(prev->compare_exchange(expected, {n, 0}))) break;
+    }
+    std::size_t b = buckets.load(std::memory_order_relaxed);
+    if(count.fetch_add(1) + 1 > (std::ptrdiff_t)(b * MAP_LOAD) && b < ((std::size_t)1 << (SEGMENTS - 2)))
+        buckets.compare_exchange_strong(b, 2 * b);
+    return true;
+}
+
+/* Lookup: copy the value out while the guard keeps the node alive */
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+bool split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::find(const K& key, V& out) {
+    std::uint64_t h = hash_of(key);
+    typename Reclaim::guard g;
+    node* start = bucket(h & (buckets.load() - 1), g);
+    marked_ptr<node>* prev;
+    node* cur;
+    if(!find(start, so_item(h), &key, prev, cur, g)) return false;
+    out = cur->item->second;
+    return true;
+}
+
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+std::optional<V> split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::find(const K& key) {
+    std::uint64_t h = hash_of(key);
+    typename Reclaim::guard g;
+    node* start = bucket(h & (buckets.load() - 1), g);
+    marked_ptr<node>* prev;
+    node* cur;
+    if(!find(start, so_item(h), &key, prev, cur, g)) return std::nullopt;
+    return cur->item->second;
+}
+
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+bool split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::contains(const K& key) {
+    std::uint64_t h = hash_of(key);
+    typename Reclaim::guard g;
+    node* start = bucket(h & (buckets.load() - 1), g);
+    marked_ptr<node>* prev;
+    node* cur;
+    return find(start, so_item(h), &key, prev, cur, g);
+}
+
+/* Erase: marking the item's next link is the linearization point and
+   freezes the link; the unlink is one more CAS, or left to the next
+   search that passes it */
+template<typename K, typename V, typename Hash, typename Reclaim, typename Alloc, typename Layout>
+bool split_ordered_map<K, V, Hash, Reclaim, Alloc, Layout>::erase(const K& key) {
+    std::uint64_t h = hash_of(key), so = so_item(h);
+    typename Reclaim::guard g;
+    node* start = bucket(h & (buckets.load() - 1), g);
+    marked_ptr<node>* prev;
+    node* cur;
+    while(true) {
+        if(!find(start, so, &key, prev, cur, g)) return false;
+        link next = cur->next.load();
+        if(next.tag) continue;
+        if(!stat_cas(cur->next.compare_exchange(next, {next.ptr, 1}))) continue;
+        link expected{cur, 0};
+        if(stat_cas(prev->compare_exchange(expected, {next.ptr, 0}))) Reclaim::retire(cur, free_node);
+        else find(start, so, &key, prev, cur, g);
+        count.fetch_sub(1);
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * spsc_ring.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: SPSC ring - wait-free single-producer single-consumer queue.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include "containers.h"
+
+template<typename T, typename Layout>
+spsc_ring<T, Layout>::spsc_ring(std::size_t capacity)
+    : cells(new cell[pow2_capacity(capacity, 1)]), mask(capacity - 1),
+      tail(0), cached_head(0), head(0), cached_tail(0) {}
+
+/* Destructor: destroy the values still in the ring */
+template<typename T, typename Layout>
+spsc_ring<T, Layout>::~spsc_ring() {
+    std::size_t end = tail.load();
+    for(std::size_t pos = head.load(); pos != end; pos++)
+        cells[pos & mask].val()->~T();
+    delete[] cells;
+}
+
+/* Full when tail is a whole lap ahead of head; the real head is only read
+   when the cached one says so */
+template<typename T, typename Layout>
+template<typename... Args>
+bool spsc_ring<T, Layout>::try_emplace(Args&&... args) {
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    if(t - cached_head > mask) {
+        cached_head = head.load(std::memory_order_acquire);
+        if(t - cached_head > mask) return false;
+    }
+    new (cells[t & mask].storage) T(std::forward<Args>(args)...);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+/* Empty when head has caught up with tail; the real tail is only read
+   when the cached one says so */
+template<typename T, typename Layout>
+bool spsc_ring<T, Layout>::try_dequeue(T& out) {
+    std::size_t h = head.load(std::memory_order_relaxed);
+    if(h == cached_tail) {
+        cached_tail = tail.load(std::memory_order_acquire);
+        if(h == cached_tail) return false;
+    }
+    T* v = cells[h & mask].val();
+    out = std::move(*v);
+    v->~T();
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Layout>
+std::optional<T> spsc_ring<T, Layout>::try_dequeue() {
+    T v;
+    if(!try_dequeue(v)) return std::nullopt;
+    return v;
+}
+
+/* Blocking enqueue: wait for the consumer to free a cell */
+template<typename T, typename Layout>
+void spsc_ring<T, Layout>::enqueue(T&& value) {
+    for(int spin = 0; !try_enqueue(std::move(value)); spin++) {
+        if(spin >= RING_SPIN) std::this_thread::yield();
+    }
+}
+
+/* Blocking dequeue: wait for the producer to fill a cell */
+template<typename T, typename Layout>
+T spsc_ring<T, Layout>::dequeue() {
+    T v;
+    for(int spin = 0; !try_dequeue(v); spin++) {
+        if(spin >= RING_SPIN) std::this_thread::yield();
+    }
+    return v;
+}
+
+#endif
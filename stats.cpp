@@ -0,0 +1,66 @@
+/*
+ * stats.cpp
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Registry of per-thread counter records.
+ */
+
+#include "stats.h"
+
+CONTAINERS_API const char* const stat_names[STAT_COUNT] = {
+    "allocs", "sys_allocs", "sys_bytes", "cas_attempts", "cas_fails",
+    "elim_attempts", "elim_hits", "fc_combines", "fc_passes", "fc_ops",
+    "fc_paired", "fc_shared", "adapt_switches", "cv_waits", "cv_sleeps", "cv_wakeups",
+    "cycles", "instructions", "cache_misses"
+};
+
+CONTAINERS_LOCAL std::atomic<thread_stats*> stats_list(nullptr);
+
+/* Records outlive their threads so exited threads still count; a new
+   thread adopts an inactive record and keeps adding to it. */
+CONTAINERS_API thread_stats* acquire_stats() {
+    for(thread_stats* r = stats_list.load(); r; r = r->next) {
+        bool expected = false;
+        if(!r->active.load() && r->active.compare_exchange_strong(expected, true))
+            return r;
+    }
+
+    thread_stats* r = new thread_stats();
+    for(int i = 0; i < STAT_COUNT; i++) r->v[i].store(0);
+    r->active.store(true);
+    r->shared = false;
+    thread_stats* old_head = stats_list.load();
+    do {
+        r->next = old_head;
+    } while(!stats_list.compare_exchange_weak(old_head, r));
+    return r;
+}
+
+CONTAINERS_API void release_stats(thread_stats* rec) {
+    rec->active.store(false);
+}
+
+/* Stays active, so it is never adopted, and is counted like any other */
+CONTAINERS_API thread_stats* orphan_stats() {
+    static thread_stats* orphans = [] {
+        thread_stats* r = acquire_stats();
+        r->shared = true;
+        return r;
+    }();
+    return orphans;
+}
+
+CONTAINERS_API stats_snapshot collect_stats() {
+    stats_snapshot s = {};
+    for(thread_stats* r = stats_list.load(); r; r = r->next)
+        for(int i = 0; i < STAT_COUNT; i++)
+            s.v[i] += r->v[i].load(std::memory_order_relaxed);
+    return s;
+}
+
+/* Only meaningful between runs, while no thread is counting */
+CONTAINERS_API void reset_stats() {
+    for(thread_stats* r = stats_list.load(); r; r = r->next)
+        for(int i = 0; i < STAT_COUNT; i++)
+            r->v[i].store(0, std::memory_order_relaxed);
+}
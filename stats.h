@@ -0,0 +1,108 @@
+/*
+ * stats.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Per-thread event counters aggregated on demand.
+ *
+ * Each thread bumps its own record with plain relaxed stores, so counting
+ * never contends; collect_stats() sums every record ever registered.
+ * Build with -DCONTAINER_STATS=0 (make STATS=0) to compile every
+ * stat_add() out of the hot paths; the counters then all read zero.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <atomic>
+#include <cstdint>
+#include "config.h"
+
+#ifndef CONTAINER_STATS
+#define CONTAINER_STATS 1
+#endif
+
+enum stat_id {
+    STAT_ALLOCS,        /* nodes handed out by an allocator */
+    STAT_SYS_ALLOCS,    /* calls into the system allocator */
+    STAT_SYS_BYTES,     /* bytes obtained from the system allocator */
+    STAT_CAS_ATTEMPTS,  /* linearizing CASes tried by the lock-free containers */
+    STAT_CAS_FAILS,     /* ... and lost to another thread */
+    STAT_ELIM_ATTEMPTS, /* pop visits to the elimination array */
+    STAT_ELIM_HITS,     /* exchanges, counted once on the pop side */
+    STAT_FC_COMBINES,   /* combine rounds run */
+    STAT_FC_PASSES,     /* passes over a publication list that found work */
+    STAT_FC_OPS,        /* requests served by combiners */
+    STAT_FC_PAIRED,     /* requests served by pairing a push with a pop */
+    STAT_FC_SHARED,     /* node batches applied under a shared combiner lock */
+    STAT_ADAPT_SWITCHES, /* adaptive_stack mode changes */
+    STAT_CV_WAITS,      /* condvar waits */
+    STAT_CV_SLEEPS,     /* ... that outlasted the spin and blocked */
+    STAT_CV_WAKEUPS,    /* notify calls that had a sleeper to wake */
+    STAT_PERF_CYCLES,   /* hardware counters, benchmark threads with -perf */
+    STAT_PERF_INSNS,
+    STAT_PERF_CACHE_MISSES,
+    STAT_COUNT
+};
+
+extern const char* const stat_names[STAT_COUNT];
+
+struct thread_stats {
+    std::atomic<std::uint64_t> v[STAT_COUNT];
+    std::atomic<bool> active;
+    bool shared;                        /* the orphan record, see below */
+    thread_stats* next;
+};
+
+struct stats_snapshot {
+    std::uint64_t v[STAT_COUNT];
+};
+
+thread_stats* acquire_stats();
+void release_stats(thread_stats* rec);
+thread_stats* orphan_stats();
+stats_snapshot collect_stats();
+void reset_stats();
+
+/* Allocator and reclaimer thread-locals destroyed after the owner still
+   count. The pointer lives in a thread-local that is never destroyed, and
+   the owner's destructor points it at the shared orphan record, so late
+   callers never touch a record another thread may have adopted. */
+namespace detail {
+struct stats_owner {
+    thread_stats*& rec;
+    explicit stats_owner(thread_stats*& slot) : rec(slot) { rec = acquire_stats(); }
+    ~stats_owner() { release_stats(rec); rec = orphan_stats(); }
+};
+}
+
+inline thread_stats& local_stats() {
+    static thread_local thread_stats* rec = nullptr;
+    static thread_local detail::stats_owner owner(rec);
+    return *rec;
+}
+
+/* Only the owning thread writes its record, no read-modify-write needed;
+   the orphan record is shared by late callers of every thread */
+#if CONTAINER_STATS
+inline void stat_add(stat_id id, std::uint64_t n = 1) {
+    thread_stats& r = local_stats();
+    std::atomic<std::uint64_t>& c = r.v[id];
+    if(r.shared) c.fetch_add(n, std::memory_order_relaxed);
+    else c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+#else
+inline void stat_add(stat_id, std::uint64_t = 1) {}
+#endif
+
+/* Count one linearizing CAS and pass its result through */
+inline bool stat_cas(bool ok) {
+    stat_add(STAT_CAS_ATTEMPTS);
+    if(!ok) stat_add(STAT_CAS_FAILS);
+    return ok;
+}
+
+#ifdef CONTAINERS_HEADER_ONLY
+#include "stats.cpp"
+#endif
+
+#endif
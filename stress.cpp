@@ -0,0 +1,127 @@
+/*
+ * stress.cpp
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Conservation and ordering checks over stress histories.
+ */
+
+#include "stress.h"
+#include <algorithm>
+#include <sstream>
+
+/* LIFO pairs are only checked within this many inserts of one thread */
+static const std::size_t LIFO_WINDOW = 32;
+
+namespace {
+
+/* First example and count of one kind of violation */
+struct violation {
+    const char* what;
+    long long count = 0;
+    std::string first;
+    explicit violation(const char* w) : what(w) {}
+
+    void add(const std::string& example) {
+        if(count++ == 0) first = example;
+    }
+    void report(std::vector<std::string>& out) const {
+        if(count == 0) return;
+        std::ostringstream s;
+        s << what << ": " << count << " (first: " << first << ")";
+        out.push_back(s.str());
+    }
+};
+
+std::string describe(std::int64_t value) {
+    std::ostringstream s;
+    s << "thread " << (value >> 32) << " value " << (value & 0xffffffff);
+    return s.str();
+}
+
+}
+
+std::vector<std::string> check_history(const std::vector<stress_history>& hist,
+                                       stress_order order, bool check_empty) {
+    violation unknown("removed a value never inserted");
+    violation twice("removed twice");
+    violation lost("lost");
+    violation early("removed before inserted");
+    violation reorder(order == ORDER_FIFO ? "FIFO order" : "LIFO order");
+    violation empty("empty while holding a value");
+
+    /* The removal of every inserted value, in the same shape as the inserts */
+    std::vector<std::vector<const stress_op*>> removed(hist.size());
+    for(std::size_t t = 0; t < hist.size(); t++)
+        removed[t].assign(hist[t].inserts.size(), nullptr);
+    for(const stress_history& h : hist) {
+        for(const stress_op& r : h.removes) {
+            std::size_t t = (std::size_t)(r.value >> 32), n = (std::size_t)(r.value & 0xffffffff);
+            if(r.value < 0 || t >= hist.size() || n >= removed[t].size()) {
+                unknown.add(describe(r.value));
+            } else if(removed[t][n]) {
+                twice.add(describe(r.value));
+            } else {
+                removed[t][n] = &r;
+                if(r.resp < hist[t].inserts[n].inv) early.add(describe(r.value));
+            }
+        }
+    }
+
+    for(std::size_t t = 0; t < hist.size(); t++) {
+        const std::vector<stress_op>& ins = hist[t].inserts;
+        const std::vector<const stress_op*>& rem = removed[t];
+        long long latest_inv = 0;       /* FIFO: latest removal start of an earlier insert */
+        for(std::size_t n = 0; n < ins.size(); n++) {
+            if(!rem[n]) {
+                lost.add(describe(stress_value(t, n)));
+                continue;
+            }
+            if(order == ORDER_FIFO) {
+                /* b inserted after a, but removed before a's removal began */
+                if(rem[n]->resp < latest_inv) reorder.add(describe(stress_value(t, n)));
+                latest_inv = std::max(latest_inv, rem[n]->inv);
+            } else if(order == ORDER_LIFO) {
+                /* a removed while b (pushed later, still there) was on top of it */
+                std::size_t lo = n > LIFO_WINDOW ? n - LIFO_WINDOW : 0;
+                for(std::size_t a = lo; a < n; a++) {
+                    if(rem[a] && ins[n].resp < rem[a]->inv && rem[a]->resp < rem[n]->inv) {
+                        reorder.add(describe(stress_value(t, a)) + " under " + std::to_string(n));
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    if(check_empty && order != ORDER_NONE) {
+        /* A failed removal [s, e] is wrong if some value was inserted before
+           s and its removal began after e. Sweep the values by insert
+           response, keeping the latest removal start seen so far. */
+        std::vector<std::pair<long long, long long>> held;     /* insert resp, removal inv */
+        std::vector<const stress_op*> fails;
+        for(std::size_t t = 0; t < hist.size(); t++) {
+            for(std::size_t n = 0; n < hist[t].inserts.size(); n++)
+                if(removed[t][n]) held.push_back({hist[t].inserts[n].resp, removed[t][n]->inv});
+            for(const stress_op& f : hist[t].empties) fails.push_back(&f);
+        }
+        std::sort(held.begin(), held.end());
+        std::sort(fails.begin(), fails.end(),
+                  [](const stress_op* a, const stress_op* b) { return a->inv < b->inv; });
+        std::size_t i = 0;
+        long long latest = 0;
+        for(const stress_op* f : fails) {
+            for(; i < held.size() && held[i].first < f->inv; i++)
+                latest = std::max(latest, held[i].second);
+            if(latest > f->resp) empty.add("at " + std::to_string(f->inv) + " ns");
+        }
+    }
+
+    std::vector<std::string> out;
+    unknown.report(out);
+    twice.report(out);
+    lost.report(out);
+    early.report(out);
+    reorder.report(out);
+    empty.report(out);
+    return out;
+}
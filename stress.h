@@ -0,0 +1,59 @@
+/*
+ * stress.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Operation histories of a stress run and their checker.
+ *
+ * Every thread logs its own operations with invoke and response times,
+ * values are (thread << 32) | n with n counting the thread's successful
+ * inserts, so the checker knows each value's insert without a search:
+ *   conservation   every inserted value removed exactly once (after a
+ *                  final drain), nothing removed that was never inserted
+ *   real time      no value removed before its insert was invoked
+ *   order          FIFO: one thread's values leave in insert order;
+ *                  LIFO: a value is not removed while a later insert of
+ *                  the same thread sits above it the whole time
+ *   empty          a failed removal while some value was in the container
+ *                  for the whole call
+ * These are necessary conditions for linearizability that can be checked
+ * in O(n log n), not a full search over all orders.
+ */
+
+#ifndef STRESS_H
+#define STRESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* Insert ops are indexed by n, removals carry the value they got */
+struct stress_op {
+    long long inv, resp;                /* steady clock, ns */
+    std::int64_t value;
+};
+
+struct stress_history {
+    std::vector<stress_op> inserts;
+    std::vector<stress_op> removes;
+    std::vector<stress_op> empties;     /* removals that found nothing */
+};
+
+enum stress_order {
+    ORDER_NONE,                         /* relaxed containers: conservation only */
+    ORDER_FIFO,
+    ORDER_LIFO
+};
+
+inline std::int64_t stress_value(std::size_t thread, std::size_t n) {
+    return ((std::int64_t)thread << 32) | (std::int64_t)n;
+}
+
+/* Check the histories of all threads together. Returns one line per kind
+   of violation found (with a count and the first example), empty if the
+   run passed. check_empty is for containers whose failed removals are
+   meant to be linearizable. */
+std::vector<std::string> check_history(const std::vector<stress_history>& hist,
+                                       stress_order order, bool check_empty);
+
+#endif
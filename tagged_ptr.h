@@ -0,0 +1,161 @@
+/*
+ * tagged_ptr.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Atomic pointer policies for the lock-free containers.
+ *
+ * A tagged pointer carries a version counter that is bumped on every
+ * store and successful CAS, so a node that is popped and pushed back
+ * (ABA) no longer matches an old snapshot. All three policies share one
+ * interface so the containers are written once against it:
+ *   load()                        snapshot {ptr, tag}
+ *   store(p)                      set ptr, bump tag
+ *   compare_exchange(exp, p)      CAS on the whole snapshot, bump tag
+ */
+
+#ifndef TAGGED_PTR_H
+#define TAGGED_PTR_H
+
+#include <atomic>
+#include <cstdint>
+
+/* Snapshot of a pointer together with its version tag */
+template<typename T>
+struct tagged {
+    T* ptr;
+    std::uintptr_t tag;
+    bool operator==(const tagged& o) const { return ptr == o.ptr && tag == o.tag; }
+    bool operator!=(const tagged& o) const { return !(*this == o); }
+};
+
+/* Raw pointer behind either a plain or a tagged snapshot */
+template<typename T> inline T* ptr_of(T* p) { return p; }
+template<typename T> inline T* ptr_of(const tagged<T>& t) { return t.ptr; }
+
+/* Plain atomic pointer, no version counter (tag always 0).
+   The default constructor leaves the word alone for node reuse, see below. */
+template<typename T>
+class plain_ptr {
+    std::atomic<T*> p;
+public:
+    static constexpr const char* name = "plain";
+    static const bool is_tagged = false;
+
+    plain_ptr() = default;
+    tagged<T> load() const { return {p.load(), 0}; }
+    void store(T* v) { p.store(v); }
+    bool compare_exchange(tagged<T>& expected, T* desired) {
+        bool ok = p.compare_exchange_strong(expected.ptr, desired);
+        expected.tag = 0;
+        return ok;
+    }
+};
+
+/* 16-bit tag packed into the unused high bits of a 48-bit x86-64/AArch64
+   user-space pointer. Single-word CAS, but the tag wraps after 65536
+   updates of the same word. */
+template<typename T>
+class packed_ptr {
+    static const int TAG_SHIFT = 48;
+    static const std::uintptr_t PTR_MASK = ((std::uintptr_t)1 << TAG_SHIFT) - 1;
+    static_assert(sizeof(void*) == 8, "packed_ptr needs 64-bit pointers");
+
+    std::atomic<std::uintptr_t> v;
+
+    static tagged<T> unpack(std::uintptr_t w) {
+        return {reinterpret_cast<T*>(w & PTR_MASK), w >> TAG_SHIFT};
+    }
+    static std::uintptr_t pack(T* p, std::uintptr_t tag) {
+        return (tag << TAG_SHIFT) | (reinterpret_cast<std::uintptr_t>(p) & PTR_MASK);
+    }
+public:
+    static constexpr const char* name = "packed";
+    static const bool is_tagged = true;
+
+    packed_ptr() = default;
+    tagged<T> load() const { return unpack(v.load()); }
+    void store(T* p) { v.store(pack(p, unpack(v.load()).tag + 1)); }
+    bool compare_exchange(tagged<T>& expected, T* desired) {
+        std::uintptr_t old_word = pack(expected.ptr, expected.tag);
+        bool ok = v.compare_exchange_strong(old_word, pack(desired, expected.tag + 1));
+        if(!ok) expected = unpack(old_word);
+        return ok;
+    }
+};
+
+/* Pointer with a deletion mark in its low bit, for lock-free lists
+   (Harris, Michael): the snapshot's tag is the mark, not a version.
+   Marking a node's next word freezes it, so a CAS on the word of a
+   deleted node fails. Nodes must be at least 2-byte aligned. */
+template<typename T>
+class marked_ptr {
+    std::atomic<std::uintptr_t> v;
+
+    static tagged<T> unpack(std::uintptr_t w) {
+        return {reinterpret_cast<T*>(w & ~(std::uintptr_t)1), w & 1};
+    }
+    static std::uintptr_t pack(tagged<T> t) {
+        return reinterpret_cast<std::uintptr_t>(t.ptr) | (t.tag & 1);
+    }
+public:
+    static constexpr const char* name = "marked";
+    static const bool is_tagged = false;
+
+    marked_ptr() = default;
+    explicit marked_ptr(T* p) : v(pack({p, 0})) {}
+    tagged<T> load() const { return unpack(v.load()); }
+    void store(T* p, bool mark = false) { v.store(pack({p, mark})); }
+    bool compare_exchange(tagged<T>& expected, tagged<T> desired) {
+        std::uintptr_t old_word = pack(expected);
+        bool ok = v.compare_exchange_strong(old_word, pack(desired));
+        if(!ok) expected = unpack(old_word);
+        return ok;
+    }
+};
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define HAVE_DWCAS 1
+
+/* Full-width tag next to the pointer, updated with a 16-byte CAS
+   (cmpxchg16b, needs -mcx16). The tag never wraps in practice. */
+template<typename T>
+class dwcas_ptr {
+    union alignas(16) word {
+        struct { T* ptr; std::uintptr_t tag; } s;
+        unsigned __int128 raw;
+    } w;
+public:
+    static constexpr const char* name = "dwcas";
+    static const bool is_tagged = true;
+
+    dwcas_ptr() = default;
+
+    /* Every write bumps the tag, so an unchanged tag around the pointer
+       read proves the two halves belong together */
+    tagged<T> load() const {
+        while(true) {
+            std::uintptr_t t = __atomic_load_n(&w.s.tag, __ATOMIC_ACQUIRE);
+            T* p = __atomic_load_n(&w.s.ptr, __ATOMIC_ACQUIRE);
+            if(__atomic_load_n(&w.s.tag, __ATOMIC_ACQUIRE) == t) return {p, t};
+        }
+    }
+    void store(T* p) {
+        tagged<T> cur = load();
+        while(!compare_exchange(cur, p)) {}
+    }
+    bool compare_exchange(tagged<T>& expected, T* desired) {
+        word old_word, new_word;
+        old_word.s.ptr = expected.ptr;
+        old_word.s.tag = expected.tag;
+        new_word.s.ptr = desired;
+        new_word.s.tag = expected.tag + 1;
+        word seen;
+        seen.raw = __sync_val_compare_and_swap(&w.raw, old_word.raw, new_word.raw);
+        if(seen.raw == old_word.raw) return true;
+        expected = {seen.s.ptr, seen.s.tag};
+        return false;
+    }
+};
+#endif
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * treiber_stack.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Treiber Stack - lock-free stack using CAS operations.
+ */
+
+#ifndef TREIBER_STACK_H
+#define TREIBER_STACK_H
+
+#include "containers.h"
+
+/* Destructor: drain and free all nodes */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+treiber_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::~treiber_stack() {
+    while(top.load().ptr) {
+        node* n = top.load().ptr;
+        top.store(n->next.load(std::memory_order_relaxed));
+        Alloc::destroy(n);
+    }
+}
+
+/* Splice a private chain first..last in with a single CAS */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+void treiber_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::link(node* first, node* last) {
+    typename Backoff::state b;
+    while(true) {
+        tagged<node> old_top = top.load();
+        last->next.store(old_top.ptr, std::memory_order_relaxed);
+        
+        /* Try to swing top pointer to the new chain */
+        if(stat_cas(top.compare_exchange(old_top, first))) return;
+        b.pause();
+    }
+}
+
+/* Lock-free push using compare-and-swap, the value is built in its node */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+template<typename... Args>
+void treiber_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::emplace(Args&&... args) {
+    node* n = Alloc::template create<node>(std::forward<Args>(args)...);
+    link(n, n);
+    nonempty.notify();
+}
+
+/* Lock-free pop using compare-and-swap */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+T treiber_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop() {
+    T v;
+    if(!try_pop(v)) throw std::runtime_error("empty");
+    return v;
+}
+
+/* Non-throwing pop: returns false if empty */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+bool treiber_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::try_pop(T& out) {
+    return pop_n(&out, 1) == 1;
+}
+
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+std::optional<T> treiber_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::try_pop() {
+    T v;
+    if(!try_pop(v)) return std::nullopt;
+    return v;
+}
+
+/* Blocking pop: spin, then sleep until a push */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+T treiber_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop_wait() {
+    T v;
+    await_item(nonempty, [&] { return try_pop(v); });
+    return v;
+}
+
+/* Timed pop: nullopt if nothing arrived before the timeout */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+template<typename Rep, typename Period>
+std::optional<T> treiber_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop_for(const std::chrono::duration<Rep, Period>& timeout) {
+    T v;
+    if(!await_item(nonempty, [&] { return try_pop(v); }, wait_deadline(timeout))) return std::nullopt;
+    return v;
+}
+
+/* Link the batch into a private chain first (values[n-1] on top), then
+   splice the whole chain in with a single CAS */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+void treiber_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::push_n(const T* values, std::size_t n) {
+    if(n == 0) return;
+    node* last = Alloc::template create<node>(values[0]);
+    node* first = last;
+    for(std::size_t i = 1; i < n; i++) {
+        node* n2 = Alloc::template create<node>(values[i]);
+        n2->next.store(first, std::memory_order_relaxed);
+        first = n2;
+    }
+    link(first, last);
+    nonempty.notify(n);
+}
+
+/* Pop up to n values, one CAS each, returns how many were popped.
+   Once the CAS has unlinked old_top no other thread can take it, so the
+   value is moved out after the CAS; readers that still hold old_top only
+   look at next. Under immediate_reclaim old_top may already be reused and
+   next rewritten while it is read, so next is atomic and the tagged CAS
+   throws the stale value away.
+   Note: old_top stays protected by the guard until it is retired */
+template<typename T, typename Reclaim, template<typename> class Ptr, typename Alloc, typename Layout, typename Backoff>
+std::size_t treiber_stack<T, Reclaim, Ptr, Alloc, Layout, Backoff>::pop_n(T* out, std::size_t n) {
+    typename Reclaim::guard g;
+    typename Backoff::state b;
+    std::size_t got = 0;
+    while(got < n) {
+        tagged<node> old_top = g.protect(0, top);
+        if(!old_top.ptr) break;
+        
+        node* next = old_top.ptr->next.load(std::memory_order_relaxed);
+        
+        /* Try to advance top to next node (the tag rejects a recycled top) */
+        if(stat_cas(top.compare_exchange(old_top, next))) {
+            out[got++] = std::move(old_top.ptr->value);
+            g.clear(0);
+            Reclaim::retire(old_top.ptr, free_node);
+        } else {
+            b.pause();
+        }
+    }
+    return got;
+}
+
+#endif
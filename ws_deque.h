@@ -0,0 +1,109 @@
+/*
+ * ws_deque.h
+ * Author: Prudhvi Raj Belide
+ *
+ * Description: Chase-Lev work-stealing deque - owner LIFO, thief FIFO.
+ */
+
+#ifndef WS_DEQUE_H
+#define WS_DEQUE_H
+
+#include "containers.h"
+
+template<typename T, typename Layout>
+ws_deque<T, Layout>::ws_deque(std::size_t capacity)
+    : top(0), bottom(0), buf(new array(pow2_capacity(capacity, 1), nullptr)) {}
+
+/* Destructor: free the current array and every array it replaced */
+template<typename T, typename Layout>
+ws_deque<T, Layout>::~ws_deque() {
+    array* a = buf.load();
+    while(a) {
+        array* prev = a->prev;
+        delete a;
+        a = prev;
+    }
+}
+
+/* Copy the live range t..b into an array twice the size. Only the owner
+   grows, so nothing moves under it; a thief that loaded the old array
+   still finds the same values there. */
+template<typename T, typename Layout>
+typename ws_deque<T, Layout>::array*
+ws_deque<T, Layout>::grow(array* a, std::int64_t t, std::int64_t b) {
+    array* bigger = new array(a->capacity() * 2, a);
+    for(std::int64_t i = t; i < b; i++) bigger->put(i, a->get(i));
+    buf.store(bigger, std::memory_order_release);
+    return bigger;
+}
+
+/* Push: a release fence makes the cell visible before the new bottom */
+template<typename T, typename Layout>
+void ws_deque<T, Layout>::push_bottom(const T& value) {
+    std::int64_t b = bottom.load(std::memory_order_relaxed);
+    std::int64_t t = top.load(std::memory_order_acquire);
+    array* a = buf.load(std::memory_order_relaxed);
+    if(b - t > (std::int64_t)a->capacity() - 1) a = grow(a, t, b);
+    a->put(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+/* Pop: reserve the bottom cell first, then look at top. Only when a
+   single item is left can a thief want the same cell, and the two settle
+   it with one CAS on top. */
+template<typename T, typename Layout>
+bool ws_deque<T, Layout>::pop_bottom(T& out) {
+    std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    array* a = buf.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top.load(std::memory_order_relaxed);
+
+    if(t > b) {
+        /* Empty: undo the reservation */
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+    out = a->get(b);
+    if(t < b) return true;
+
+    /* Last item: race the thieves for it */
+    bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return won;
+}
+
+template<typename T, typename Layout>
+std::optional<T> ws_deque<T, Layout>::pop_bottom() {
+    T v;
+    if(!pop_bottom(v)) return std::nullopt;
+    return v;
+}
+
+/* Steal: read top before bottom, then claim the top cell with a CAS */
+template<typename T, typename Layout>
+bool ws_deque<T, Layout>::steal(T& out) {
+    std::int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t b = bottom.load(std::memory_order_acquire);
+    if(t >= b) return false;
+
+    array* a = buf.load(std::memory_order_acquire);
+    T v = a->get(t);
+    if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed))
+        return false;
+    out = v;
+    return true;
+}
+
+template<typename T, typename Layout>
+std::optional<T> ws_deque<T, Layout>::steal() {
+    T v;
+    if(!steal(v)) return std::nullopt;
+    return v;
+}
+
+#endif